@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yeschief.h>
+
+/**
+ * Throughput of `CLI::runBatch` on 100k argument lists depending on the thread count. Items per second should grow
+ * linearly with it
+ */
+static auto BM_runBatch(benchmark::State &state) -> void {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "A number", {.required = true})
+        .addOption<std::string>("label,l", "A label")
+        .addOption("verbose,v", "Verbose");
+    std::vector<std::vector<std::string>> argvs;
+    for (int i = 0; i < 100000; i++) {
+        argvs.push_back({"name", "-v", "--label=batch", "-n", std::to_string(i)});
+    }
+
+    for (auto _ : state) {
+        auto results = cli.runBatch(argvs, static_cast<unsigned>(state.range(0)));
+        benchmark::DoNotOptimize(results);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(argvs.size()));
+}
+
+BENCHMARK(BM_runBatch)
+    ->RangeMultiplier(2)
+    ->Range(1, static_cast<int64_t>(std::max(1U, std::thread::hardware_concurrency())))
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
@@ -0,0 +1,44 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "benchmark_tools.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <yeschief.h>
+
+/**
+ * Complete an option name among range(0) options, after a flag
+ */
+static auto BM_completeOptionName(benchmark::State &state) -> void {
+    const auto cli                       = syntheticCLI(static_cast<size_t>(state.range(0)));
+    const std::vector<std::string> words = {"-a", "--int-99"};
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(cli.complete(words));
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_completeOptionName)->RangeMultiplier(4)->Range(64, 16384)->Complexity();
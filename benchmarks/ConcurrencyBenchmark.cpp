@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <yeschief.h>
+
+namespace {
+auto buildCLI() -> yeschief::CLI {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "A number", {.required = true})
+        .addOption<std::vector<double>>("values", "Some values")
+        .addOption<std::string>("label,l", "A label", {.default_value = std::string("none")})
+        .addOption("verbose,v", "Verbose");
+    cli.parsePositional("number", "values");
+
+    return cli;
+}
+
+const auto MAX_THREADS = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+} // namespace
+
+/**
+ * Throughput of `CLI::run` when all threads share the same CLI, each one with its own ParseContext. Items per second
+ * should grow linearly with the thread count
+ */
+static auto BM_runSharedCLI(benchmark::State &state) -> void {
+    static const auto cli = buildCLI();
+    thread_local yeschief::ParseContext context;
+    std::vector<std::string> strings = {"name", "-v", "--label", "benchmark", "--", "42", "1.5", "2.5", "3.5"};
+    std::vector<char *> arguments;
+    for (auto &string : strings) {
+        arguments.push_back(string.data());
+    }
+
+    for (auto _ : state) {
+        auto result = cli.run(static_cast<int>(arguments.size()), arguments.data(), context);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_runSharedCLI)->ThreadRange(1, MAX_THREADS)->UseRealTime();
@@ -0,0 +1,120 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "benchmark_tools.hpp"
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <vector>
+#include <yeschief.h>
+
+/**
+ * Run a CLI with a positional list of range(0) values of type T, converted in parallel when range(1) is 1. Comparing
+ * both series shows from which size the parallel conversion is worth it, to tune
+ * `DEFAULT_PARALLEL_CONVERSION_THRESHOLD`
+ */
+template<typename T>
+static auto BM_convertList(benchmark::State &state) -> void {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<T>>("values", "Values");
+    cli.parsePositional("values");
+    cli.setParallelConversionThreshold(state.range(1) == 1 ? 1 : 0);
+
+    std::vector<std::string> strings = {"name"};
+    for (int64_t i = 0; i < state.range(0); i++) {
+        strings.push_back(std::to_string(i * 7 % 100000));
+    }
+    SyntheticArgv argv(std::move(strings));
+    if (! cli.run(argv.argc(), argv.argv()).has_value()) {
+        state.SkipWithError("Synthetic argv cannot be parsed");
+    }
+
+    for (auto _ : state) {
+        auto result = cli.run(argv.argc(), argv.argv());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_convertList, int)
+    ->ArgNames({"values", "parallel"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_convertList, float)
+    ->ArgNames({"values", "parallel"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_convertList, double)
+    ->ArgNames({"values", "parallel"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0, 1}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_convertList, std::string)
+    ->ArgNames({"values", "parallel"})
+    ->ArgsProduct({benchmark::CreateRange(1 << 10, 1 << 20, 4), {0}})
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Deserialize results holding a list of range(0) numbers of type T, the way a worker process gets them from the one
+ * which parsed argv. Compare with BM_convertList parsing the same list
+ */
+template<typename T>
+static auto BM_deserializeList(benchmark::State &state) -> void {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<T>>("values", "Values");
+    cli.parsePositional("values");
+
+    std::vector<std::string> strings = {"name"};
+    for (int64_t i = 0; i < state.range(0); i++) {
+        strings.push_back(std::to_string(i * 7 % 100000));
+    }
+    SyntheticArgv argv(std::move(strings));
+    const auto results = cli.run(argv.argc(), argv.argv());
+    if (! results.has_value()) {
+        state.SkipWithError("Synthetic argv cannot be parsed");
+        return;
+    }
+    const auto data = results->serialize(cli.fingerprint()).value();
+
+    for (auto _ : state) {
+        auto result = yeschief::CLIResults::deserialize(data, cli.fingerprint());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK_TEMPLATE(BM_deserializeList, int)
+    ->ArgNames({"values"})
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(BM_deserializeList, double)
+    ->ArgNames({"values"})
+    ->RangeMultiplier(4)
+    ->Range(1 << 10, 1 << 20)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
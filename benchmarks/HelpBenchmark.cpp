@@ -0,0 +1,130 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "benchmark_tools.hpp"
+
+#include <benchmark/benchmark.h>
+#include <optional>
+#include <sstream>
+#include <yeschief.h>
+
+/**
+ * Write the help of a CLI with range(0) options, rendered on first iteration only
+ */
+static auto BM_helpWithOptions(benchmark::State &state) -> void {
+    const auto cli = syntheticCLI(static_cast<size_t>(state.range(0)));
+    std::ostringstream out;
+
+    for (auto _ : state) {
+        out.str("");
+        cli.help(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(out.str().size()));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_helpWithOptions)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Render the help of a fresh CLI with range(0) options on each iteration
+ */
+static auto BM_renderHelpWithOptions(benchmark::State &state) -> void {
+    // Replaced while timing is paused, so that destroying the previous CLI is not measured
+    std::optional<yeschief::CLI> cli;
+    std::ostringstream out;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        cli.emplace(syntheticCLI(static_cast<size_t>(state.range(0))));
+        out.str("");
+        state.ResumeTiming();
+        cli->help(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(out.str().size()));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_renderHelpWithOptions)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Render the help of a fresh CLI with range(0) options on each iteration, descriptions wrapped to 20 columns
+ */
+static auto BM_renderWrappedHelpWithOptions(benchmark::State &state) -> void {
+    std::optional<yeschief::CLI> cli;
+    std::ostringstream out;
+
+    for (auto _ : state) {
+        state.PauseTiming();
+        cli.emplace(syntheticCLI(static_cast<size_t>(state.range(0))));
+        cli->setHelpWidth(20);
+        out.str("");
+        state.ResumeTiming();
+        cli->help(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(out.str().size()));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_renderWrappedHelpWithOptions)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Display width of a text of range(0) bytes, ASCII only when range(1) is 0, else with one non ASCII character in 8
+ */
+static auto BM_displayWidth(benchmark::State &state) -> void {
+    std::string text;
+    while (text.size() < static_cast<size_t>(state.range(0))) {
+        text += state.range(1) == 0 ? "abcdefgh" : "abcdeé";
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(yeschief::displayWidth(text));
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+}
+
+BENCHMARK(BM_displayWidth)->ArgsProduct({{64, 4096}, {0, 1}});
+
+/**
+ * Write the help of a CLI with range(0) commands, rendered on first iteration only
+ */
+static auto BM_helpWithCommands(benchmark::State &state) -> void {
+    const auto commands = syntheticCommands(static_cast<size_t>(state.range(0)));
+    yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+    for (const auto &command : commands) {
+        cli.addCommand(command.get());
+    }
+    std::ostringstream out;
+
+    for (auto _ : state) {
+        out.str("");
+        cli.help(out);
+        benchmark::DoNotOptimize(out);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(out.str().size()));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_helpWithCommands)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
@@ -0,0 +1,194 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "../src/utils.h"
+#include "benchmark_tools.hpp"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <yeschief.h>
+
+/**
+ * Count of options of the CLI parsing synthetic argvs
+ */
+constexpr size_t PARSE_OPTION_COUNT = 64;
+
+/**
+ * Tokenize an argv of range(0) arguments written with style range(1) (see `ArgvStyle`)
+ */
+static auto BM_parseArgv(benchmark::State &state) -> void {
+    const auto allowed_options = syntheticAllowedOptions(PARSE_OPTION_COUNT);
+    auto argv                  = syntheticArgv(
+        static_cast<size_t>(state.range(0)), PARSE_OPTION_COUNT, static_cast<ArgvStyle>(state.range(1))
+    );
+
+    // Like CLI::run, program name is not given to parseArgv
+    if (! yeschief::parseArgv(argv.argc() - 1, argv.argv() + 1, allowed_options).has_value()) {
+        state.SkipWithError("Synthetic argv cannot be parsed");
+    }
+
+    for (auto _ : state) {
+        auto result = yeschief::parseArgv(argv.argc() - 1, argv.argv() + 1, allowed_options);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_parseArgv)
+    ->ArgNames({"size", "style"})
+    ->ArgsProduct({benchmark::CreateRange(1, 100000, 10), {0, 1, 2}})
+    ->Complexity();
+
+/**
+ * Run a CLI on an argv of range(0) arguments written with style range(1) (see `ArgvStyle`): tokenizing, converting
+ * values and building results
+ */
+static auto BM_run(benchmark::State &state) -> void {
+    const auto cli = syntheticCLI(PARSE_OPTION_COUNT);
+    auto argv      = syntheticArgv(
+        static_cast<size_t>(state.range(0)), PARSE_OPTION_COUNT, static_cast<ArgvStyle>(state.range(1))
+    );
+
+    if (! cli.run(argv.argc(), argv.argv()).has_value()) {
+        state.SkipWithError("Synthetic argv cannot be parsed");
+    }
+
+    for (auto _ : state) {
+        auto result = cli.run(argv.argc(), argv.argv());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_run)
+    ->ArgNames({"size", "style"})
+    ->ArgsProduct({benchmark::CreateRange(1, 100000, 10), {0, 1, 2}})
+    ->Complexity();
+
+/**
+ * Run a CLI of range(0) options matching prefixes on 8 of them, given by their full name when range(1) is 0, else
+ * abbreviated
+ */
+static auto BM_runWithPrefixMatching(benchmark::State &state) -> void {
+    const auto option_count = static_cast<size_t>(state.range(0));
+    yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+    cli.setPrefixMatching(true);
+    for (size_t i = 0; i < option_count; i++) {
+        cli.addOption("option-" + std::to_string(i) + "-name", "A flag of the synthetic CLI");
+    }
+    std::vector<std::string> strings = {"synthetic"};
+    for (size_t i = 0; i < 8; i++) {
+        const auto name = "--option-" + std::to_string(i * option_count / 8) + "-name";
+        strings.push_back(state.range(1) == 0 ? name : name.substr(0, name.size() - 3));
+    }
+    SyntheticArgv argv(std::move(strings));
+
+    if (! cli.run(argv.argc(), argv.argv()).has_value()) {
+        state.SkipWithError("Synthetic argv cannot be parsed");
+    }
+
+    for (auto _ : state) {
+        auto result = cli.run(argv.argc(), argv.argv());
+        benchmark::DoNotOptimize(result);
+    }
+}
+
+BENCHMARK(BM_runWithPrefixMatching)->ArgNames({"options", "abbreviated"})->ArgsProduct({{64, 1024, 16384}, {0, 1}});
+
+/**
+ * Suggest names for a misspelled option among range(0) names
+ */
+static auto BM_suggest(benchmark::State &state) -> void {
+    std::vector<std::string> names;
+    for (int64_t i = 0; i < state.range(0); i++) {
+        names.push_back("option-" + std::to_string(i) + "-name");
+    }
+
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(yeschief::suggest("opiton-1234-name", names));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_suggest)->RangeMultiplier(8)->Range(64, 32768)->Complexity();
+
+/**
+ * Run a CLI of range(0) int options, each having an environment variable, a quarter of them being set
+ */
+static auto BM_runWithEnvironment(benchmark::State &state) -> void {
+    const auto option_count = static_cast<size_t>(state.range(0));
+    yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+    for (size_t i = 0; i < option_count; i++) {
+        const auto name = "int-" + std::to_string(i);
+        cli.addOption<int>(name, "An int option of the synthetic CLI", {.env = "SYNTHETIC_INT_" + std::to_string(i)});
+        if (i % 4 == 0) {
+            setenv(("SYNTHETIC_INT_" + std::to_string(i)).c_str(), "42", 1);
+        }
+    }
+    SyntheticArgv argv({"synthetic"});
+
+    for (auto _ : state) {
+        auto result = cli.run(argv.argc(), argv.argv());
+        benchmark::DoNotOptimize(result);
+    }
+    for (size_t i = 0; i < option_count; i += 4) {
+        unsetenv(("SYNTHETIC_INT_" + std::to_string(i)).c_str());
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_runWithEnvironment)->RangeMultiplier(8)->Range(8, 4096)->Complexity();
+
+/**
+ * Run a CLI of range(0) int options, all of them set by its config file
+ */
+static auto BM_runWithConfigFile(benchmark::State &state) -> void {
+    const auto option_count = static_cast<size_t>(state.range(0));
+    const std::string path  = "/tmp/yeschief-benchmark-" + std::to_string(option_count) + ".conf";
+    yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+    {
+        std::ofstream file(path);
+        for (size_t i = 0; i < option_count; i++) {
+            const auto name = "int-" + std::to_string(i);
+            cli.addOption<int>(name, "An int option of the synthetic CLI");
+            file << name << " = 42\n";
+        }
+    }
+    const auto config = yeschief::ConfigFile::open(path);
+    std::remove(path.c_str());
+    cli.setConfigFile(&config.value());
+    SyntheticArgv argv({"synthetic"});
+
+    for (auto _ : state) {
+        auto result = cli.run(argv.argc(), argv.argv());
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_runWithConfigFile)->RangeMultiplier(8)->Range(8, 4096)->Complexity();
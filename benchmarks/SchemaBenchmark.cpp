@@ -0,0 +1,113 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "benchmark_tools.hpp"
+
+#include <benchmark/benchmark.h>
+#include <map>
+#include <yeschief.h>
+
+/**
+ * Build a CLI with range(0) options
+ */
+static auto BM_buildCLIWithOptions(benchmark::State &state) -> void {
+    const auto names = syntheticOptionNames(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+        for (size_t i = 0; i < names.size(); i++) {
+            if (i < FLAG_LETTERS.size()) {
+                cli.addOption(names[i], "A flag of the synthetic CLI");
+            } else {
+                cli.addOption<int>(names[i], "An int option of the synthetic CLI");
+            }
+        }
+        benchmark::DoNotOptimize(cli);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_buildCLIWithOptions)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Build a CLI with range(0) commands, each of them setting up its own CLI
+ */
+static auto BM_buildCLIWithCommands(benchmark::State &state) -> void {
+    const auto commands = syntheticCommands(static_cast<size_t>(state.range(0)));
+
+    for (auto _ : state) {
+        yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+        for (const auto &command : commands) {
+            cli.addCommand(command.get());
+        }
+        benchmark::DoNotOptimize(cli);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_buildCLIWithCommands)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Load a CLI with range(0) options from its binary schema, to compare with BM_buildCLIWithOptions
+ */
+static auto BM_loadSchemaWithOptions(benchmark::State &state) -> void {
+    const auto schema = syntheticCLI(static_cast<size_t>(state.range(0))).exportSchema();
+
+    for (auto _ : state) {
+        yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+        auto result = cli.loadSchema(schema);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(cli);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_loadSchemaWithOptions)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
+
+/**
+ * Load a CLI with range(0) commands from its binary schema, to compare with BM_buildCLIWithCommands
+ */
+static auto BM_loadSchemaWithCommands(benchmark::State &state) -> void {
+    const auto commands = syntheticCommands(static_cast<size_t>(state.range(0)));
+    std::map<std::string, yeschief::Command *, std::less<>> bound_commands;
+    yeschief::CLI exported_cli("synthetic", "Synthetic CLI for benchmarks");
+    for (const auto &command : commands) {
+        exported_cli.addCommand(command.get());
+        bound_commands.emplace(command->getName(), command.get());
+    }
+    const auto schema = exported_cli.exportSchema();
+
+    for (auto _ : state) {
+        yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+        auto result = cli.loadSchema(schema, bound_commands);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(cli);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+    state.SetComplexityN(state.range(0));
+}
+
+BENCHMARK(BM_loadSchemaWithCommands)->RangeMultiplier(4)->Range(1, 4096)->Complexity();
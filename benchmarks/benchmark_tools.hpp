@@ -0,0 +1,216 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef BENCHMARK_TOOLS_H
+#define BENCHMARK_TOOLS_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yeschief.h>
+
+/**
+ * Letters used as short names of flags, in the order they are defined
+ */
+constexpr std::string_view FLAG_LETTERS = "abcdefghijklmnopqrstuvwxyz";
+
+/**
+ * Way values and flags are written in a synthetic argv
+ */
+enum class ArgvStyle : int64_t {
+    /**
+     * `--int-1 42 --flag-a --flag-b`
+     */
+    Separated = 0,
+    /**
+     * `--int-1=42 --flag-a --flag-b`
+     */
+    Equal     = 1,
+    /**
+     * `--int-1 42 -ab`
+     */
+    Bundled   = 2,
+};
+
+/**
+ * An argv keeping its strings alive
+ */
+class SyntheticArgv final {
+  public:
+    explicit SyntheticArgv(std::vector<std::string> strings): _strings(std::move(strings)) {
+        _argv.reserve(_strings.size());
+        for (auto &string : _strings) {
+            _argv.push_back(string.data());
+        }
+    }
+
+    SyntheticArgv(const SyntheticArgv &)                    = delete;
+    auto operator=(const SyntheticArgv &) -> SyntheticArgv & = delete;
+
+    [[nodiscard]] auto argc() const -> int {
+        return static_cast<int>(_argv.size());
+    }
+
+    [[nodiscard]] auto argv() -> char ** {
+        return _argv.data();
+    }
+
+    [[nodiscard]] auto strings() const -> const std::vector<std::string> & {
+        return _strings;
+    }
+
+  private:
+    std::vector<std::string> _strings;
+    std::vector<char *> _argv;
+};
+
+/**
+ * Names of the options of `syntheticCLI`, in the format of `CLI::addOption`
+ */
+inline auto syntheticOptionNames(const size_t option_count) -> std::vector<std::string> {
+    std::vector<std::string> names;
+    names.reserve(option_count);
+    for (size_t i = 0; i < option_count; i++) {
+        if (i < FLAG_LETTERS.size()) {
+            names.push_back("flag-" + std::string(1, FLAG_LETTERS[i]) + "," + FLAG_LETTERS[i]);
+        } else {
+            names.push_back("int-" + std::to_string(i));
+        }
+    }
+
+    return names;
+}
+
+/**
+ * Build a CLI with option_count options: first ones are flags with a short name (up to 26), next ones are int options
+ */
+inline auto syntheticCLI(const size_t option_count) -> yeschief::CLI {
+    yeschief::CLI cli("synthetic", "Synthetic CLI for benchmarks");
+    const auto names = syntheticOptionNames(option_count);
+    for (size_t i = 0; i < names.size(); i++) {
+        if (i < FLAG_LETTERS.size()) {
+            cli.addOption(names[i], "A flag of the synthetic CLI");
+        } else {
+            cli.addOption<int>(names[i], "An int option of the synthetic CLI", {.value_help = "INT"});
+        }
+    }
+
+    return cli;
+}
+
+/**
+ * Allowed options of `syntheticCLI`, as given to `parseArgv`
+ */
+inline auto syntheticAllowedOptions(const size_t option_count) -> std::vector<std::string> {
+    std::vector<std::string> allowed_options;
+    for (size_t i = 0; i < option_count; i++) {
+        if (i < FLAG_LETTERS.size()) {
+            allowed_options.push_back("flag-" + std::string(1, FLAG_LETTERS[i]));
+            allowed_options.emplace_back(1, FLAG_LETTERS[i]);
+        } else {
+            allowed_options.push_back("int-" + std::to_string(i));
+        }
+    }
+
+    return allowed_options;
+}
+
+/**
+ * Build an argv of size arguments (program name excluded) matching `syntheticCLI(option_count)`, option_count being
+ * greater than 26. The same size and style always give the same argv
+ */
+inline auto syntheticArgv(const size_t size, const size_t option_count, const ArgvStyle style) -> SyntheticArgv {
+    std::vector<std::string> strings = {"synthetic"};
+    strings.reserve(size + 1);
+    const auto int_count = option_count - FLAG_LETTERS.size();
+    size_t option        = 0;
+    while (strings.size() <= size) {
+        const auto remaining = size + 1 - strings.size();
+        // Alternate an int option with its value and a group of 4 flags
+        if (option % 2 == 0 && (style == ArgvStyle::Equal || remaining >= 2)) {
+            const auto name  = "--int-" + std::to_string(FLAG_LETTERS.size() + option % int_count);
+            const auto value = std::to_string(option * 7 % 1000);
+            if (style == ArgvStyle::Equal) {
+                strings.push_back(name + "=" + value);
+            } else {
+                strings.push_back(name);
+                strings.push_back(value);
+            }
+        } else if (style == ArgvStyle::Bundled) {
+            std::string bundle = "-";
+            for (size_t i = 0; i < 4; i++) {
+                bundle += FLAG_LETTERS[(option + i) % FLAG_LETTERS.size()];
+            }
+            strings.push_back(bundle);
+        } else {
+            strings.push_back("--flag-" + std::string(1, FLAG_LETTERS[option % FLAG_LETTERS.size()]));
+        }
+        option++;
+    }
+
+    return SyntheticArgv(std::move(strings));
+}
+
+/**
+ * A command doing nothing, with an int option
+ */
+class SyntheticCommand final : public yeschief::Command {
+  public:
+    explicit SyntheticCommand(std::string name): _name(std::move(name)) {}
+
+    [[nodiscard]] auto getName() const -> std::string override {
+        return _name;
+    }
+
+    [[nodiscard]] auto getDescription() const -> std::string override {
+        return "A command of the synthetic CLI";
+    }
+
+    auto setup(yeschief::CLI &cli) -> void override {
+        cli.addOption<int>("number,n", "A number");
+    }
+
+    auto run(const yeschief::CLIResults &) -> int override {
+        return 0;
+    }
+
+  private:
+    std::string _name;
+};
+
+/**
+ * Build command_count commands named `command-<i>`
+ */
+inline auto syntheticCommands(const size_t command_count) -> std::vector<std::unique_ptr<SyntheticCommand>> {
+    std::vector<std::unique_ptr<SyntheticCommand>> commands;
+    commands.reserve(command_count);
+    for (size_t i = 0; i < command_count; i++) {
+        commands.push_back(std::make_unique<SyntheticCommand>("command-" + std::to_string(i)));
+    }
+
+    return commands;
+}
+
+#endif // BENCHMARK_TOOLS_H
@@ -30,15 +30,28 @@
  * Usage documentation is available here: [Usage documentation](USAGE.md)
  */
 
+#include <algorithm>
 #include <any>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
 #include <expected>
+#include <functional>
 #include <iostream>
 #include <map>
+#include <memory_resource>
 #include <memory>
+#include <mutex>
 #include <optional>
-#include <regex>
+#include <span>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
 #include <vector>
 
 #define assert_message(expr, message) assert((message, expr))
@@ -48,6 +61,18 @@ class CLI;
 class OptionGroup;
 class Command;
 class CLIResults;
+class IncrementalParser;
+class ParseContext;
+struct ArgvParsingResult;
+struct ArgvParsingState;
+class PrefixIndex;
+class BinaryReader;
+
+/**
+ * Default minimum count of values of a list option to convert them in parallel, see
+ * `CLI::setParallelConversionThreshold`
+ */
+constexpr size_t DEFAULT_PARALLEL_CONVERSION_THRESHOLD = 65536;
 
 /**
  * Advanced configuration of an option
@@ -71,6 +96,17 @@ typedef struct OptionConfiguration {
      * Implicit value for this option. Will be set if option is given by the user without a value
      */
     std::optional<std::any> implicit_value = std::nullopt;
+    /**
+     * Name of an environment variable giving the value of this option when it is not in argv. It takes precedence over
+     * `default_value` and is converted like a value from argv, a list option gets a single value from it. Empty for
+     * none
+     */
+    std::string env                        = "";
+    /**
+     * Candidates for values of this option, for values only known at runtime. It receives the value being completed,
+     * returned candidates not starting with it are dropped. Called by `CLI::complete`, default to no candidate
+     */
+    std::function<std::vector<std::string>(std::string_view value)> completion = nullptr;
 } OptionConfiguration;
 
 /**
@@ -101,22 +137,264 @@ enum class FaultType {
      * Command not found
      */
     UnknownCommand,
+    /**
+     * User have given the prefix of several options or commands, see `CLI::setPrefixMatching`
+     */
+    AmbiguousPrefix,
+    /**
+     * A line of the config file is not an entry nor a section, see `ConfigFile`
+     */
+    InvalidConfigFile,
+    /**
+     * Serialized results are truncated or were written for another CLI, see `CLIResults::deserialize`
+     */
+    InvalidSerializedResults,
+    /**
+     * A value of results has not the type of an option, so it cannot be serialized, see `CLIResults::serialize`
+     */
+    UnserializableValue,
+    /**
+     * A schema describes a CLI that `addOption` and `addCommand` cannot build, see `CLI::loadSchema`
+     */
+    InvalidSchema,
 };
 
 /**
- * Wrapper around an exception message
+ * Where the token of a Fault comes from
  */
-typedef struct Fault {
+enum class TokenSource {
+    /**
+     * Arguments of the program
+     */
+    Argv,
     /**
-     * The message of the exception. Can be useful for the user to understand what is wrong
+     * Environment variable of an option, see `OptionConfiguration::env`
      */
-    std::string message;
+    Environment,
+    /**
+     * Config file, see `ConfigFile`
+     */
+    ConfigFile,
+};
+
+/**
+ * Why parsing failed. It only holds structured data, the human-readable message is built on demand by `message`, this
+ * way a failed parse costs almost nothing when the Fault is discarded
+ */
+typedef struct Fault {
     /**
      * Type of the fault
      */
     FaultType type;
+    /**
+     * Long name of the option concerned, if any. Valid as long as the CLI is
+     */
+    std::string_view option                      = {};
+    /**
+     * Offending argument or value, if any. It is a view on argv (or on arguments kept by `IncrementalParser`), valid
+     * as long as they are. For a value read from the environment or from a `ConfigFile`, it is a view on them
+     */
+    std::string_view token                       = {};
+    /**
+     * Where token comes from. An option named in argv is written `--name` in messages, a key of the config file as is
+     */
+    TokenSource source                           = TokenSource::Argv;
+    /**
+     * Position in argv of the argument containing token, program name being 0. For a command, it is the position in
+     * the arguments of the command
+     */
+    std::optional<size_t> argument_index         = std::nullopt;
+    /**
+     * For `InvalidOptionType`, name of the type token cannot be parsed to
+     */
+    std::string_view expected_type               = {};
+    /**
+     * For `MissingRequiredOption`, long names of all options missing
+     */
+    std::vector<std::string_view> missing_options = {};
+    /**
+     * For `AmbiguousPrefix`, names of all options or commands starting with token. Valid as long as the CLI is
+     */
+    std::vector<std::string_view> candidates      = {};
+    /**
+     * CLI whose options or commands are concerned, if any. Valid as long as it is
+     */
+    const CLI *cli                                = nullptr;
+
+    /**
+     * For `UnrecognizedOption` and `UnknownCommand`, names of the closest options or commands of cli, best first, to
+     * suggest them. They are searched on each call, so that a Fault nobody reads costs nothing more
+     *
+     * It reads token: argv must still be alive
+     */
+    [[nodiscard]] auto suggestions() const -> std::vector<std::string_view>;
+
+    /**
+     * Build the human-readable message of the fault, with its suggestions. Can be useful for the user to understand
+     * what is wrong.
+     *
+     * It reads token: argv must still be alive
+     */
+    [[nodiscard]] auto message() const -> std::string;
 } Fault;
 
+/**
+ * Category of the error codes made of a FaultType, for functions also returning errors of the system. Their message is
+ * the one of a Fault of this type
+ */
+auto faultCategory() -> const std::error_category &;
+
+/**
+ * Allows `std::error_code code = FaultType::InvalidSchema` and comparing an error code to a FaultType
+ */
+auto make_error_code(FaultType type) -> std::error_code;
+
+/**
+ * Phases of a run timed by a `Profiler`
+ */
+enum class ProfilePhase {
+    /**
+     * Split arguments into options, values and positional arguments
+     */
+    Tokenize,
+    /**
+     * Find values given for each option
+     */
+    Lookup,
+    /**
+     * Convert values to the type of their option
+     */
+    Conversion,
+    /**
+     * Set default values of options not given
+     */
+    Defaults,
+    /**
+     * Check required options are given
+     */
+    RequiredChecks,
+    /**
+     * Find the command to run and its CLI
+     */
+    CommandDispatch,
+};
+
+/**
+ * Count of values of `ProfilePhase`
+ */
+constexpr size_t PROFILE_PHASE_COUNT = 6;
+
+/**
+ * Durations and counts of a single run. Durations of a command CLI are added to the ones of its parent
+ */
+typedef struct RunProfile {
+    /**
+     * Time spent in each phase, indexed by `ProfilePhase`
+     */
+    std::array<std::chrono::nanoseconds, PROFILE_PHASE_COUNT> durations = {};
+    /**
+     * Time spent in the whole run, command execution excluded
+     */
+    std::chrono::nanoseconds total   = {};
+    /**
+     * Time spent running the command, if any
+     */
+    std::chrono::nanoseconds command = {};
+    /**
+     * Count of arguments parsed, program name excluded
+     */
+    size_t tokens                    = 0;
+    /**
+     * Count of options receiving a value from arguments
+     */
+    size_t options_matched           = 0;
+    /**
+     * Count of values converted to their option type
+     */
+    size_t values_converted          = 0;
+
+    [[nodiscard]] auto duration(const ProfilePhase phase) const -> std::chrono::nanoseconds {
+        return durations[static_cast<size_t>(phase)];
+    }
+} RunProfile;
+
+/**
+ * Receive the profile of each run of a CLI, see `CLI::setProfiler`
+ */
+class Profiler {
+  public:
+    /**
+     * Called at the end of each run, failed ones included. When the CLI is run concurrently, it is called concurrently
+     * too
+     *
+     * @param profile Profile of the run
+     */
+    virtual auto record(const RunProfile &profile) -> void = 0;
+
+    virtual ~Profiler() = default;
+};
+
+/**
+ * Print a breakdown of profile, one line per phase. It is what `--yeschief-profile` prints
+ *
+ * @param profile Profile to print
+ * @param out Out stream on which profile is printed
+ */
+auto printProfile(const RunProfile &profile, std::ostream &out) -> void;
+
+/**
+ * Types allowed for options. It stands in for typeid, so that the library does not need RTTI
+ */
+enum class OptionType {
+    Boolean,
+    String,
+    Int,
+    Float,
+    Double,
+    BooleanList,
+    StringList,
+    IntList,
+    FloatList,
+    DoubleList,
+};
+
+/**
+ * @return OptionType of T, nothing if T is not allowed for options
+ */
+template<typename T>
+constexpr auto optionTypeOf() -> std::optional<OptionType> {
+    if constexpr (std::is_same_v<T, bool>) {
+        return OptionType::Boolean;
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        return OptionType::String;
+    } else if constexpr (std::is_same_v<T, int>) {
+        return OptionType::Int;
+    } else if constexpr (std::is_same_v<T, float>) {
+        return OptionType::Float;
+    } else if constexpr (std::is_same_v<T, double>) {
+        return OptionType::Double;
+    } else if constexpr (std::is_same_v<T, std::vector<bool>>) {
+        return OptionType::BooleanList;
+    } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+        return OptionType::StringList;
+    } else if constexpr (std::is_same_v<T, std::vector<int>>) {
+        return OptionType::IntList;
+    } else if constexpr (std::is_same_v<T, std::vector<float>>) {
+        return OptionType::FloatList;
+    } else if constexpr (std::is_same_v<T, std::vector<double>>) {
+        return OptionType::DoubleList;
+    } else {
+        return std::nullopt;
+    }
+}
+
+/**
+ * @return Whether type is a list of numbers, which takes all the remaining positional arguments
+ */
+constexpr auto isNumberListType(const OptionType type) -> bool {
+    return type == OptionType::IntList || type == OptionType::FloatList || type == OptionType::DoubleList;
+}
+
 /**
  * An option, nothing else
  */
@@ -136,13 +414,145 @@ struct Option {
     /**
      * Type of the option (bool,int,...)
      */
-    const std::type_info &type;
+    OptionType type;
     /**
      * Advanced configuration of the option
      */
     OptionConfiguration configuration;
 };
 
+/**
+ * Shells for which `CLI::completionScript` generates completion scripts
+ */
+enum class Shell { Bash, Zsh, Fish };
+
+/**
+ * An option known at compile time, see `StaticSchema`
+ */
+typedef struct StaticOption {
+    /**
+     * Name of the option (`--name`)
+     */
+    std::string_view name;
+    /**
+     * Short name of the option (`-n`), empty if none
+     */
+    std::string_view short_name;
+    std::string_view description;
+    OptionType type             = OptionType::Boolean;
+    bool required               = false;
+    /**
+     * Placeholder in help message for the option value
+     */
+    std::string_view value_help = "VALUE";
+    /**
+     * Name of the group of the option, empty for the default one
+     */
+    std::string_view group;
+    /**
+     * Environment variable giving the value of the option when it is not in argv, see `OptionConfiguration::env`
+     */
+    std::string_view env;
+} StaticOption;
+
+/**
+ * Options of a CLI known at compile time. Its help can be rendered at compile time by `staticHelp`, and the CLI itself
+ * is built from it by `CLI(const StaticSchema &)`. Only options are supported, not commands
+ *
+ * Options and positional names are usually `static constexpr` arrays:
+ *
+ * ```cpp
+ * static constexpr std::array<yeschief::StaticOption, 2> options = {{
+ *     {.name = "verbose", .short_name = "v", .description = "Verbose output"},
+ *     {.name = "file", .description = "File to read", .type = yeschief::OptionType::String, .required = true},
+ * }};
+ * static constexpr std::array<std::string_view, 1> positional = {"file"};
+ * static constexpr yeschief::StaticSchema schema = {"my-program", "Description", options, positional};
+ * ```
+ */
+typedef struct StaticSchema {
+    std::string_view name;
+    std::string_view description;
+    std::span<const StaticOption> options;
+    /**
+     * Names of the options parsed as positional arguments, in order
+     */
+    std::span<const std::string_view> positional;
+} StaticSchema;
+
+/**
+ * @return Usage line of schema, the one following `usage:` in help
+ */
+constexpr auto renderUsageHelp(const StaticSchema &schema) -> std::string;
+
+/**
+ * @param width Count of columns descriptions are wrapped to, 0 to not wrap them
+ * @return Help message of schema, the same `CLI::help` displays for the CLI built from it
+ */
+constexpr auto renderHelp(const StaticSchema &schema, size_t width = 0) -> std::string;
+
+/**
+ * Help message of schema rendered at compile time, without trailing null character. Descriptions are wrapped to
+ * width columns, unless it is 0. Display it with a single write:
+ *
+ * ```cpp
+ * static constexpr auto help = yeschief::staticHelp<schema>();
+ * std::cout.write(help.data(), help.size());
+ * ```
+ */
+template<const StaticSchema &schema, size_t width = 0> constexpr auto staticHelp();
+
+/**
+ * File giving values to options, see `CLI::setConfigFile`. It is memory-mapped when opened and read in place on each
+ * run, without copying its content.
+ *
+ * It is made of `key = value` lines. Keys are long option names, a key alone is the same as `key = true` and each line
+ * of a list option adds a value to it. Values may be quoted with `'` or `"`, spaces around keys and values are ignored.
+ * Lines starting with `#` or `;` are comments. A `[section]` line starts the options of a command, `[command.sub]` the
+ * ones of its sub command:
+ *
+ * ```ini
+ * # Options of the CLI
+ * verbose
+ * output = "out.txt"
+ *
+ * [build]
+ * jobs = 4
+ * ```
+ */
+class ConfigFile final {
+  public:
+    /**
+     * @param path Path of the file
+     * @return The mapped file, or the error of the system when it cannot be read. A missing file is
+     * `std::errc::no_such_file_or_directory`, many programs do not require one
+     */
+    [[nodiscard]] static auto open(const std::string &path) -> std::expected<ConfigFile, std::error_code>;
+
+    ConfigFile(ConfigFile &&other) noexcept;
+
+    auto operator=(ConfigFile &&other) noexcept -> ConfigFile &;
+
+    ConfigFile(const ConfigFile &) = delete;
+
+    auto operator=(const ConfigFile &) -> ConfigFile & = delete;
+
+    ~ConfigFile();
+
+    /**
+     * @return Content of the file, valid as long as the ConfigFile is
+     */
+    [[nodiscard]] auto content() const -> std::string_view;
+
+  private:
+    /**
+     * Content mapped in memory
+     */
+    std::string_view _content;
+
+    explicit ConfigFile(std::string_view content);
+};
+
 /**
  * Represents a group of options under the same namespace
  */
@@ -186,10 +596,17 @@ class OptionGroup final {
 
 /**
  * Main class of the library. It represents the program itself and manage options and commands
+ *
+ * Once configured, all the const methods of a CLI, `run` included, can be called concurrently from several threads on
+ * the same instance. The only state they change is lazily built caches (help text, prefix indexes, fingerprint), which
+ * synchronize their first build internally and are then read without locking. Configuration (`addOption`, `addGroup`,
+ * `addCommand`, `parsePositional`, ...) invalidates those caches and must be done before sharing the CLI
  */
 class CLI final {
+    friend struct Fault;
     friend class OptionGroup;
     friend class HelpCommand;
+    friend class IncrementalParser;
 
     enum class Mode { OPTIONS, COMMANDS };
 
@@ -200,6 +617,13 @@ class CLI final {
      */
     CLI(std::string name, std::string description);
 
+    /**
+     * Build the CLI described by schema: its options, groups and positional arguments
+     *
+     * @param schema Schema of your program, see `StaticSchema`
+     */
+    explicit CLI(const StaticSchema &schema);
+
     /**
      * Add an option to your program.
      *
@@ -220,6 +644,69 @@ class CLI final {
     addOption(const std::string &name, const std::string &description, const OptionConfiguration &configuration = {})
         -> CLI &;
 
+    /**
+     * Record durations and counts of each run in profiler. It costs nothing when no profiler is set.
+     *
+     * Whatever the profiler, giving `--yeschief-profile` as first argument of `run(int, char **)` or
+     * `runCommand(int, char **)` profiles the run and prints a breakdown on STDERR (see `printProfile`). This switch is
+     * hidden: it is not displayed in help and never reaches your options. Other runs take it as any other argument
+     *
+     * @param profiler Profiler to use, nullptr to disable it. It must outlive the CLI
+     * @return The CLI object itself to chain calls
+     */
+    auto setProfiler(Profiler *profiler) -> CLI &;
+
+    /**
+     * Lists of int, float or double receiving at least threshold values are converted by several threads, each one
+     * converting a chunk of the values. When several values are invalid, the Fault returned is still the one of the
+     * first of them.
+     *
+     * Below the threshold, starting threads costs more than it saves. Lists too short to give a few thousands values to
+     * each thread, and lists converted by a thread of `runBatch`, are always converted serially.
+     * Default to `DEFAULT_PARALLEL_CONVERSION_THRESHOLD`
+     *
+     * @param threshold Minimum count of values to convert in parallel, 0 to always convert serially
+     * @return The CLI object itself to chain calls
+     */
+    auto setParallelConversionThreshold(size_t threshold) -> CLI &;
+
+    /**
+     * Wrap descriptions in help to width columns. Commands added afterward use the same width.
+     *
+     * By default, descriptions are wrapped to the width of the terminal `help` writes to (STDOUT or STDERR), detected
+     * on each display of help. Otherwise, they are not wrapped
+     *
+     * @param width Count of columns of help lines, 0 to not wrap them
+     * @return The CLI object itself to chain calls
+     */
+    auto setHelpWidth(size_t width) -> CLI &;
+
+    /**
+     * Accept unambiguous prefixes of long option names and command names, for example `--verb` for `--verbose` or
+     * `stat` for `status`. A prefix of several names is a Fault listing them. Commands added afterward match prefixes
+     * too.
+     *
+     * Exact names are looked up first, as if prefix matching was disabled. Prefixes are only looked up when there is no
+     * exact match, in an index built on first need with a cost depending on the length of the prefix only
+     *
+     * @param enabled Whether prefixes are accepted. Default to `false`
+     * @return The CLI object itself to chain calls
+     */
+    auto setPrefixMatching(bool enabled) -> CLI &;
+
+    /**
+     * Take values of options from file, read once on each run. Commands, even added afterward, take theirs from the
+     * section named after them.
+     *
+     * A value given in argv comes first, then the one of the environment variable of the option, then the one of file,
+     * then the default value. A key or a section matching no option or command is a Fault, like an unknown option in
+     * argv
+     *
+     * @param file File to read, nullptr to not read any. It must outlive the CLI and the Faults of its runs
+     * @return The CLI object itself to chain calls
+     */
+    auto setConfigFile(const ConfigFile *file) -> CLI &;
+
     /**
      * Add a group of options to your program. You can then add options to your group the exact same way you add them to
      * the current class
@@ -262,12 +749,94 @@ class CLI final {
      * In both case if something went wrong during argv parsing, the method will return a Fault with the corresponding
      * message
      *
+     * When a command is launched, the process exits with the command's exit code. Use `CLI::runCommand` to get it back
+     * instead
+     *
      * @param argc Count of argument
      * @param argv Array of argument
      * @return The result of the parsing or a Fault if something went wrong
      */
     auto run(int argc, char **argv) const -> std::expected<CLIResults, Fault>;
 
+    /**
+     * Same as `run` but instead of stopping on the first Fault, go through all of argv and return every Fault found:
+     * unrecognized options, invalid values, missing values, missing required options, ... Faults are sorted by their
+     * position in argv, the ones without position (missing required options) last.
+     *
+     * Argv is still scanned once. Only CLIs using options can be run this way
+     *
+     * @param argc Number of arguments
+     * @param argv Array of argument
+     * @return The result of the parsing or all Faults found
+     */
+    auto runCollectingFaults(int argc, char **argv) const -> std::expected<CLIResults, std::vector<Fault>>;
+
+    /**
+     * Parse many argument lists at once, spread across a pool of threads sharing this CLI. Each thread reuses its own
+     * ParseContext and steals work from the others when it is done with its share, results are returned in the same
+     * order as argvs.
+     *
+     * Each argument list must contain the executable name first, like argv. Only CLIs using options can be run in batch
+     *
+     * @param argvs Argument lists to parse
+     * @param thread_count Number of threads to use, 0 to use all available cores
+     * @return For each argument list, the result of its parsing or a Fault if something went wrong
+     */
+    [[nodiscard]] auto runBatch(std::span<const std::vector<std::string>> argvs, unsigned thread_count = 0) const
+        -> std::vector<std::expected<CLIResults, Fault>>;
+
+    /**
+     * Parse argv against defined commands and launch the corresponding command, like `CLI::run` does, but return its
+     * exit code instead of exiting the process. This is the one to use when several threads dispatch commands with the
+     * same CLI, bearing in mind that `Command::run` of your commands are then called concurrently
+     *
+     * @param argc Count of argument
+     * @param argv Array of argument
+     * @return Exit code of the command, std::nullopt if no command was given, or a Fault if something went wrong
+     */
+    auto runCommand(int argc, char **argv) const -> std::expected<std::optional<int>, Fault>;
+
+    /**
+     * Same as `CLI::runCommand(int, char **)` using buffers of context, see `CLI::run(int, char **, ParseContext &)`
+     *
+     * @param argc Count of argument
+     * @param argv Array of argument
+     * @param context Buffers to use
+     * @return Exit code of the command, std::nullopt if no command was given, or a Fault if something went wrong
+     */
+    auto runCommand(int argc, char **argv, ParseContext &context) const -> std::expected<std::optional<int>, Fault>;
+
+    /**
+     * Same as `CLI::run(int, char **)` but all memory needed by the parsing and the results is allocated from resource
+     * (for example a `std::pmr::monotonic_buffer_resource` on the stack). Results remain usable as long as resource
+     * lives.
+     *
+     * Values held by `std::any` that do not fit in its small buffer (strings, lists) are still allocated with `new`, as
+     * their type is the one you retrieve with `std::any_cast`
+     *
+     * @param argc Count of argument
+     * @param argv Array of argument
+     * @param resource Memory resource used for all allocations
+     * @return The result of the parsing or a Fault if something went wrong
+     */
+    auto run(int argc, char **argv, std::pmr::memory_resource *resource) const -> std::expected<CLIResults, Fault>;
+
+    /**
+     * Same as `CLI::run(int, char **)` but all buffers used during the parsing, including the results, are taken from
+     * context. They are cleared but not deallocated between 2 runs, so a context kept by the caller (for example
+     * thread-local) makes repeated parsing free of most heap allocations.
+     *
+     * A context can be used with any CLI, but by only one run at a time
+     *
+     * @param argc Count of argument
+     * @param argv Array of argument
+     * @param context Buffers to use
+     * @return The result of the parsing, stored in context and valid until its next use, or a Fault if something went
+     * wrong
+     */
+    auto run(int argc, char **argv, ParseContext &context) const
+        -> std::expected<std::reference_wrapper<const CLIResults>, Fault>;
+
     /**
      * Display a help message built from defined options or commands with this template:
      *
@@ -305,30 +874,334 @@ class CLI final {
      *
      * To see example of outputs, please refer to the usage documentation: [Usage documentation](USAGE.md)
      *
+     * The message is rendered on first call, then kept and written at once until options or commands change. Help
+     * wrapped to the width of a terminal, when no width is set with `setHelpWidth`, is rendered on each call as the
+     * terminal can be resized
+     *
      * @param out Out stream on which help message is printed (default to console output STDOUT)
      */
     auto help(std::ostream &out = std::cout) const -> void;
 
-  private:
-    std::string _name;
-    std::string _description;
+    /**
+     * Generate a completion script for shell, completing options, commands and their values. Values of string options
+     * and positional arguments are completed with file names, bool options take no value and numbers get no
+     * completion.
+     *
+     * The script is static: completing does not launch your program, except for values of options having a
+     * `completion` which are asked to it with `__complete` (see `CLI::complete`). Install it where your shell loads
+     * completions from, for example `/usr/share/bash-completion/completions/<program name>` for bash,
+     * `/usr/share/zsh/site-functions/_<program name>` for zsh or `/usr/share/fish/vendor_completions.d/<program
+     * name>.fish` for fish
+     *
+     * @param shell Shell the script is for
+     * @return The completion script
+     */
+    [[nodiscard]] auto completionScript(Shell shell) const -> std::string;
+
+    /**
+     * Candidates for the last of words: option names, command names, or values given by the `completion` of the option
+     * it would be the value of. Nothing is completed after a word the parsing rejects.
+     *
+     * `run(argc, argv)` and `runCommand(argc, argv)` answer `<program> __complete <words...>` with these candidates,
+     * one per line, before anything else: `runCommand` then returns 0 without launching a command and `run` exits with
+     * code 0. Runs given a `ParseContext` and batches take `__complete` as an ordinary argument. Scripts of
+     * `completionScript` call it to complete options having a `completion`, run your CLI before any costly
+     * initialization to answer fast.
+     *
+     * Words naming commands are resolved as `runCommand` does, by prefix too when `setPrefixMatching` is enabled.
+     * Option and command names are looked up by prefix in their sorted index, the cost depends on the count of
+     * candidates and not on the count of options
+     *
+     * @param words Arguments following the program name, the last one being completed (empty for a new one)
+     * @return Candidates for the last word
+     */
+    [[nodiscard]] auto complete(std::span<const std::string> words) const -> std::vector<std::string>;
+
+    /**
+     * Hash of what results of this CLI are made of: names, short names and types of options, positional options, and
+     * commands with theirs. Descriptions and values are left out. Computed on first call
+     *
+     * @return Fingerprint of the CLI, the same for CLIs configured the same way, whatever the process
+     */
+    [[nodiscard]] auto fingerprint() const -> uint64_t;
+
+    /**
+     * Export the whole CLI in a compact binary form: options with their group and configuration, positional options,
+     * and commands with theirs. Write it to a file when building your program, `loadSchemaFile` then configures the
+     * same CLI at startup without running `addOption` and `addCommand` again.
+     *
+     * The `completion` of options cannot be exported, neither can default and implicit values not of the type of their
+     * option. Numbers are written as they are in memory: load the schema on the same kind of machine
+     *
+     * @return The binary schema
+     */
+    [[nodiscard]] auto exportSchema() const -> std::string;
+
+    /**
+     * Export the same as `exportSchema` in JSON, to inspect the CLI with other tools. Each CLI is an object with its
+     * `name`, `description`, `options`, `positional` option names and `commands`, each command being a CLI:
+     *
+     * ```json
+     * {"name": "my-program", "description": "Description", "options": [{"name": "jobs", "short_name": "j",
+     * "description": "Count of jobs", "group": "", "type": "int", "required": false, "value_help": "VALUE", "env": "",
+     * "default_value": 4}], "positional": [], "commands": []}
+     * ```
+     *
+     * Options without default or implicit value have no `default_value` or `implicit_value`
+     *
+     * @return The JSON schema, on a single line
+     */
+    [[nodiscard]] auto exportSchemaJson() const -> std::string;
+
+    /**
+     * Configure this CLI, which must not have options nor commands yet, from a schema written by `exportSchema`.
+     * Options and commands are added as they were exported, without splitting their names again. The name and
+     * description of the CLI become the ones of the schema
+     *
+     * @param schema Binary schema
+     * @param commands Command run for each command of the schema, by name, `command.sub` for a sub command. Their
+     * `setup` is not called, their CLI comes from the schema
+     * @return Nothing, `std::errc::illegal_byte_sequence` when schema is truncated or is not one,
+     * `FaultType::InvalidSchema` when it describes a CLI `addOption` and `addCommand` would refuse (options and
+     * commands not matching its mode, values not of the type of their option, names used twice), or
+     * `std::errc::invalid_argument` when a command of the schema is missing from commands. The CLI must not be used
+     * then
+     */
+    auto loadSchema(std::string_view schema, const std::map<std::string, Command *, std::less<>> &commands = {})
+        -> std::expected<void, std::error_code>;
+
+    /**
+     * Same as `loadSchema`, the schema being read from the file at path, memory-mapped
+     *
+     * @return Nothing, an error of `loadSchema`, or the error of the system when the file cannot be read
+     */
+    auto loadSchemaFile(const std::string &path, const std::map<std::string, Command *, std::less<>> &commands = {})
+        -> std::expected<void, std::error_code>;
+
+  private:
+    /**
+     * Value built on first use from the configuration of the CLI, it can be used by several threads. Once built, it is
+     * read without taking any lock. A copy gets the built value too
+     */
+    template<typename T> class Cached final {
+      public:
+        Cached() = default;
+
+        Cached(const Cached &other) {
+            std::lock_guard lock(other._mutex);
+            _value = other._value;
+            _built.store(_value.has_value(), std::memory_order_relaxed);
+        }
+
+        auto operator=(const Cached &other) -> Cached & {
+            if (this != &other) {
+                std::scoped_lock lock(_mutex, other._mutex);
+                _value = other._value;
+                _built.store(_value.has_value(), std::memory_order_release);
+            }
+
+            return *this;
+        }
+
+        /**
+         * @param build Called to build the value when it is not already, by a single thread
+         * @return The built value
+         */
+        template<typename Build> auto get(Build &&build) const -> const T & {
+            if (_built.load(std::memory_order_acquire)) {
+                return *_value;
+            }
+
+            std::lock_guard lock(_mutex);
+            if (! _value.has_value()) {
+                _value = build();
+                _built.store(true, std::memory_order_release);
+            }
+
+            return *_value;
+        }
+
+        /**
+         * Drop the built value, to call on each change of the CLI it depends on. Unlike `get`, it cannot be called
+         * while the CLI is used
+         */
+        auto invalidate() -> void {
+            std::lock_guard lock(_mutex);
+            _built.store(false, std::memory_order_relaxed);
+            _value.reset();
+        }
+
+      private:
+        mutable std::mutex _mutex;
+        mutable std::optional<T> _value;
+        /**
+         * Set once value is built, it is then never written again until invalidated
+         */
+        mutable std::atomic<bool> _built = false;
+    };
+
+    std::string _name;
+    std::string _description;
     std::optional<Mode> _mode;
     std::map<std::string, OptionGroup> _groups;
-    std::map<std::string, std::shared_ptr<const Option>> _options;
+    std::map<std::string, std::shared_ptr<const Option>, std::less<>> _options;
+    std::map<std::string, std::shared_ptr<const Option>, std::less<>> _short_options;
+    /**
+     * Options having an environment variable, by name of the variable
+     */
+    std::map<std::string, std::shared_ptr<const Option>, std::less<>> _env_options;
     std::vector<std::string> _positional_options;
-    std::map<std::string, Command *> _commands;
-    std::map<std::string, CLI> _commands_cli;
+    size_t _parallel_conversion_threshold = DEFAULT_PARALLEL_CONVERSION_THRESHOLD;
+    Profiler *_profiler                   = nullptr;
+    std::optional<size_t> _help_width;
+    bool _prefix_matching          = false;
+    const ConfigFile *_config_file = nullptr;
+    /**
+     * Section of the config file holding the options of this CLI, empty for the top-level one
+     */
+    std::string _config_section;
+    std::map<std::string, Command *, std::less<>> _commands;
+    std::map<std::string, CLI, std::less<>> _commands_cli;
+    Cached<std::string> _help;
+    Cached<std::shared_ptr<const PrefixIndex>> _option_prefixes;
+    Cached<std::shared_ptr<const PrefixIndex>> _command_prefixes;
+    Cached<uint64_t> _fingerprint;
 
-    [[nodiscard]] auto buildUsageHelp() const -> std::string;
+    [[nodiscard]] auto findOption(std::string_view name) const -> std::shared_ptr<const Option>;
+
+    /**
+     * @return Whether name is the long or short name of an option, without building a pointer to it as `findOption`
+     */
+    [[nodiscard]] auto hasOption(std::string_view name) const -> bool;
 
-    [[nodiscard]] auto buildPositionalHelp() const -> std::string;
+    /**
+     * @param name Long or short name of an option, or the prefix of a long name when prefix matching is enabled
+     * @return The option, `nullptr` if there is none or the prefix is ambiguous
+     */
+    [[nodiscard]] auto resolveOption(std::string_view name) const -> std::shared_ptr<const Option>;
+
+    /**
+     * @return Index of long option names, `nullptr` if prefix matching is disabled
+     */
+    [[nodiscard]] auto optionPrefixes() const -> const PrefixIndex *;
+
+    /**
+     * @param name Name of a command, or its prefix when prefix matching is enabled
+     * @return Full name of the command, or a Fault without token nor position
+     */
+    [[nodiscard]] auto resolveCommand(std::string_view name) const -> std::expected<std::string_view, Fault>;
+
+    /**
+     * Parse arguments of this CLI, which uses options, into context without clearing it. It is the part of `run`
+     * following the clear, also used for the arguments of a command
+     */
+    auto parseArguments(int argc, char **argv, ParseContext &context) const
+        -> std::expected<std::reference_wrapper<const CLIResults>, Fault>;
 
-    [[nodiscard]] static auto buildOptionUsageHelp(const std::shared_ptr<const Option> &option) -> std::string;
+    /**
+     * Find the command given by argv and run it, without clearing context: the config file read by a parent command is
+     * kept for its sub commands. It is the part of `runCommand` following the clear
+     */
+    auto dispatchCommand(int argc, char **argv, ParseContext &context) const
+        -> std::expected<std::optional<int>, Fault>;
+
+    /**
+     * Check sections of the config file and keys of the section of this CLI, storing their values in context sorted by
+     * option name. Keys and sections of other commands are left to them. The file is scanned on the first call of a
+     * run, the next levels of commands look up the entries kept by context
+     *
+     * @param keep_going Called with each Fault, reading stops on the first one it returns false for
+     */
+    [[nodiscard]] auto readConfigFile(ParseContext &context, const std::function<bool(Fault &&)> &keep_going) const
+        -> std::expected<void, Fault>;
 
-    static auto checkOptionType(const std::type_info &type) -> void;
+    /**
+     * When faults is given, faults are added to it and building continues with the next option instead of returning
+     * the first one
+     */
+    [[nodiscard]] auto buildResults(
+        const ArgvParsingResult &parse_result, ParseContext &context, std::vector<Fault> *faults = nullptr
+    ) const -> std::expected<void, Fault>;
 
-    [[nodiscard]] static auto
-    getValueForOption(const std::shared_ptr<const Option> &option, const std::vector<std::string> &values)
+    /**
+     * @param width Count of columns to wrap descriptions to, 0 to not wrap them
+     */
+    [[nodiscard]] auto buildHelp(size_t width) const -> std::string;
+
+    /**
+     * Options in the order of help: by group, then in the order they were added
+     */
+    [[nodiscard]] auto completionOptions() const -> std::vector<std::shared_ptr<const Option>>;
+
+    /**
+     * Positional arguments are completed with file names, unless one of them has a `completion`
+     */
+    [[nodiscard]] auto completesPositionalFiles() const -> bool;
+
+    [[nodiscard]] auto completesPositionalValues() const -> bool;
+
+    /**
+     * Write candidates for words to STDOUT, one per line
+     */
+    auto printCompletion(std::span<char *const> words) const -> void;
+
+    auto appendBashCompletion(std::string &script, std::string_view indent) const -> void;
+
+    /**
+     * Bash completion of a CLI using commands, dispatching to the completion of each command. It expects the words of
+     * the parent commands to be skipped by `$i`
+     */
+    auto appendBashCommands(std::string &script, std::string_view indent) const -> void;
+
+    /**
+     * @param values Zsh action completing values with `__complete`
+     */
+    auto appendZshCompletion(std::string &script, std::string_view indent, std::string_view values) const -> void;
+
+    /**
+     * Zsh completion of a CLI using commands, dispatching to the completion of each command
+     *
+     * @param path Names of the parent commands, each followed by a space
+     */
+    auto appendZshCommands(
+        std::string &script, std::string_view indent, std::string_view program, const std::string &path
+    ) const -> void;
+
+    auto appendSchema(std::string &out) const -> void;
+
+    auto appendSchemaJson(std::string &out) const -> void;
+
+    /**
+     * Read this CLI and its commands from reader, see `loadSchema`
+     *
+     * @param path Path of this CLI in commands, empty for the top-level one
+     */
+    auto readSchema(
+        BinaryReader &reader, const std::map<std::string, Command *, std::less<>> &commands, const std::string &path
+    ) -> std::expected<void, std::error_code>;
+
+    /**
+     * @param condition Condition for fish to apply completions of this CLI, empty if always
+     */
+    auto appendFishCompletion(std::string &script, std::string_view program, const std::string &condition) const
+        -> void;
+
+    /**
+     * Fish completion of a CLI using commands, see `appendFishCompletion`
+     */
+    auto appendFishCommands(std::string &script, std::string_view program, const std::string &condition) const
+        -> void;
+
+    [[nodiscard]] auto buildUsageHelp() const -> std::string;
+
+    /**
+     * Schema of the options of this CLI, its options and positional names are stored in the given vectors
+     */
+    [[nodiscard]] auto buildSchema(std::vector<StaticOption> &options, std::vector<std::string_view> &positional) const
+        -> StaticSchema;
+
+    [[nodiscard]] auto
+    getValueForOption(const std::shared_ptr<const Option> &option, std::span<const std::string_view> values) const
         -> std::expected<std::any, Fault>;
 
     template<typename T = bool>
@@ -385,11 +1258,19 @@ class Command {
  * Contains options values collected by parsing argv
  */
 class CLIResults final {
+    friend class ParseContext;
+    friend class CLI;
+    friend class IncrementalParser;
+
   public:
     /**
      * @param values Values for each given option
+     * @param resource Memory resource used to store values
      */
-    explicit CLIResults(const std::map<std::string, std::any> &values);
+    explicit CLIResults(
+        const std::map<std::string, std::any> &values,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource()
+    );
 
     /**
      * Returns value set by the user for a specific option. If the user doesn't have set the option, then it returns
@@ -400,8 +1281,200 @@ class CLIResults final {
      */
     [[nodiscard]] auto get(const std::string &option) const -> std::optional<std::any>;
 
+    /**
+     * Write results in a compact binary form, to hand them to another process (through a pipe or a file it maps)
+     * without it parsing argv again. Numbers are written as they are in memory: only a process of the same machine can
+     * read them back, with `deserialize`.
+     *
+     * Only values of the types of options can be written, see `OptionType`. A default value of another type, given to
+     * `addOption`, makes serialization fail
+     *
+     * @param fingerprint Fingerprint of the CLI results come from, see `CLI::fingerprint`
+     * @return The serialized results, or an `UnserializableValue` Fault naming the option of a value without the type
+     * of an option, valid as long as results are
+     */
+    [[nodiscard]] auto serialize(uint64_t fingerprint) const -> std::expected<std::string, Fault>;
+
+    /**
+     * Read results written by `serialize`. Values are copied out of data, lists of numbers with a single copy each
+     *
+     * @param data Serialized results
+     * @param fingerprint Fingerprint of the CLI of the reading process, it must be the one results were serialized with
+     * @param resource Memory resource used to store values
+     * @return The results, or an `InvalidSerializedResults` Fault when data is truncated or comes from another CLI
+     */
+    [[nodiscard]] static auto deserialize(
+        std::string_view data,
+        uint64_t fingerprint,
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource()
+    ) -> std::expected<CLIResults, Fault>;
+
   private:
-    std::map<std::string, std::any> _values;
+    std::pmr::map<std::pmr::string, std::any, std::less<>> _values;
+};
+
+/**
+ * Buffers used by `CLI::run` to parse argv, kept between runs to avoid allocating them again and again. Clearing it
+ * keeps the memory allocated: argv values, lists of values and results nodes are reused by the next run.
+ *
+ * Values that do not fit in the small buffer of `std::string` or `std::any` (long strings, lists) still need their
+ * own allocation
+ */
+class ParseContext final {
+    friend class CLI;
+    friend class IncrementalParser;
+
+  public:
+    /**
+     * @param resource Memory resource used for all buffers and results
+     */
+    explicit ParseContext(std::pmr::memory_resource *resource = std::pmr::get_default_resource());
+
+    ParseContext(const ParseContext &) = delete;
+
+    auto operator=(const ParseContext &) -> ParseContext & = delete;
+
+    ~ParseContext();
+
+  private:
+    std::unique_ptr<ArgvParsingState> _state;
+    std::pmr::vector<std::string_view> _values;
+    /**
+     * Name of the option and value of the environment variables of options found in the environment
+     */
+    std::pmr::vector<std::pair<std::string_view, std::string_view>> _environment_values;
+    /**
+     * Name of the option and value of each entry of the config file for the CLI run, in the order of the file for a
+     * same option
+     */
+    std::pmr::vector<std::pair<std::string_view, std::string_view>> _config_values;
+
+    /**
+     * Entry of the config file, with an empty key at the start of each section
+     */
+    struct ConfigEntry {
+        std::string_view section;
+        std::string_view key;
+        std::string_view value;
+    };
+
+    /**
+     * Entries of the config file in its order, scanned once per run for all levels of commands
+     */
+    std::pmr::vector<ConfigEntry> _config_entries;
+    /**
+     * Whether the config file was scanned in this run, `_config_fault` holding the invalid line it stopped at
+     */
+    bool _config_read = false;
+    std::optional<Fault> _config_fault;
+    CLIResults _results;
+    std::pmr::multimap<std::pmr::string, std::any, std::less<>> _free_nodes;
+    /**
+     * Profile of the current run, if it is profiled
+     */
+    RunProfile *_profile = nullptr;
+
+    auto clear() -> void;
+
+    auto setValue(std::string_view option, std::any value) -> void;
+};
+
+/**
+ * What an IncrementalParser expects as next argument
+ */
+enum class ExpectationType {
+    /**
+     * An option (`--name`, `-n`) or, if the CLI has some, a positional argument
+     */
+    OptionOrPositional,
+    /**
+     * A value for the last given option. For a bool option, another option is also accepted
+     */
+    OptionValue,
+    /**
+     * Only positional arguments are accepted (after `--` or after a first positional argument)
+     */
+    Positional,
+    /**
+     * The name of a command
+     */
+    Command,
+    /**
+     * No more argument is accepted
+     */
+    Nothing,
+};
+
+/**
+ * Next argument expected by an IncrementalParser
+ */
+typedef struct Expectation {
+    /**
+     * Kind of argument expected
+     */
+    ExpectationType type;
+    /**
+     * Option whose value is expected: the one waiting for a value, or the next positional one. `nullptr` if there is
+     * none
+     */
+    std::shared_ptr<const Option> option = nullptr;
+} Expectation;
+
+/**
+ * Parse arguments one at a time against a CLI, keeping the parsing state between them. It is meant for interactive
+ * shells and completion: push each completed argument, then ask what is expected next.
+ *
+ * The parser is copyable, a copy taken before pushing an argument can be used to go back. After a Fault, the state
+ * of the parser is unspecified until it is reset
+ */
+class IncrementalParser final {
+  public:
+    /**
+     * @param cli CLI to parse against. It must outlive the parser
+     */
+    explicit IncrementalParser(const CLI &cli);
+
+    IncrementalParser(const IncrementalParser &other);
+
+    auto operator=(const IncrementalParser &other) -> IncrementalParser &;
+
+    ~IncrementalParser();
+
+    /**
+     * Parse a new argument. Cost only depends on the argument, not on the ones pushed before
+     *
+     * @param argument The argument, as it would appear in argv
+     * @return Nothing or a Fault if the argument cannot be accepted
+     */
+    auto push(const std::string &argument) -> std::expected<void, Fault>;
+
+    /**
+     * @return What is expected as next argument
+     */
+    [[nodiscard]] auto expects() const -> Expectation;
+
+    /**
+     * Build results from the arguments pushed so far, exactly as `CLI::run` would do. In commands mode, the command
+     * is not run, results of its own options are returned
+     *
+     * @return The result of the parsing or a Fault if something went wrong
+     */
+    [[nodiscard]] auto finish() const -> std::expected<CLIResults, Fault>;
+
+    /**
+     * Forget all pushed arguments
+     */
+    auto reset() -> void;
+
+  private:
+    const CLI *_cli;
+    std::unique_ptr<ArgvParsingState> _state;
+    std::unique_ptr<IncrementalParser> _command_parser;
+
+    /**
+     * Push again arguments parsed in state
+     */
+    auto replay(const ArgvParsingState &state) -> void;
 };
 
 /**
@@ -432,6 +1505,8 @@ class HelpCommand final : public Command {
 };
 } // namespace yeschief
 
+template<> struct std::is_error_code_enum<yeschief::FaultType> : std::true_type {};
+
 template<typename T>
 auto yeschief::OptionGroup::addOption(
     const std::string &name, const std::string &description, const OptionConfiguration &configuration
@@ -458,28 +1533,35 @@ auto yeschief::CLI::addOption(
         ! _mode.has_value() || _mode.value() != Mode::COMMANDS, "Cannot add an option group to a cli using commands"
     );
     _mode = Mode::OPTIONS;
+    _help.invalidate();
+    _option_prefixes.invalidate();
+    _fingerprint.invalidate();
 
     assert_message(! _options.contains(name), "CLI has already this option");
     assert_message(_groups.contains(group_name), "Option group does not exist");
 
     std::string long_name = name;
     std::string short_name;
-    const std::regex name_regex("(.*),(.*)");
-    if (std::smatch match; std::regex_match(name, match, name_regex)) {
-        if (match.size() == 3) {
-            long_name  = match[1].str();
-            short_name = match[2].str();
-            assert_message(
-                short_name.length() == 1 && isalpha(short_name[0]), "Short name of an option can be only one letter"
-            );
-        }
+    if (const auto comma = name.rfind(','); comma != std::string::npos) {
+        long_name  = name.substr(0, comma);
+        short_name = name.substr(comma + 1);
+        assert_message(
+            short_name.length() == 1 && isalpha(short_name[0]), "Short name of an option can be only one letter"
+        );
     }
 
-    const auto &type_info = typeid(T);
-    checkOptionType(type_info);
-    const auto option = std::make_shared<Option>(long_name, short_name, description, type_info, configuration);
+    constexpr auto type = optionTypeOf<T>();
+    static_assert(type.has_value(), "Type is not allowed for options");
+    const auto option = std::make_shared<Option>(long_name, short_name, description, type.value(), configuration);
     _options.emplace(long_name, option);
-    _groups.at(group_name).addOption(option);
+    if (! short_name.empty()) {
+        _short_options.emplace(short_name, option);
+    }
+    if (! configuration.env.empty()) {
+        assert_message(! _env_options.contains(configuration.env), "Environment variable is already used by an option");
+        _env_options.emplace(configuration.env, option);
+    }
+    _groups.find(group_name)->second.addOption(option);
 
     return *this;
 }
@@ -487,14 +1569,12 @@ auto yeschief::CLI::addOption(
 template<typename... Tail>
 auto yeschief::CLI::parsePositional(const std::string &option_name, Tail &&...options) -> void {
     assert_message(_options.contains(option_name), "Option doesn't exists");
-    const auto option = _options.at(option_name);
+    const auto option = _options.find(option_name)->second;
     if (! _positional_options.empty()) {
-        const auto last_option_name  = _positional_options[_positional_options.size() - 1];
-        const auto last_option       = _options.at(last_option_name);
-        const auto &last_option_type = last_option->type;
+        const auto last_option_name = _positional_options[_positional_options.size() - 1];
+        const auto last_option      = _options.find(last_option_name)->second;
         assert_message(
-            last_option_type != typeid(std::vector<int>) && last_option_type != typeid(std::vector<float>)
-                && last_option_type != typeid(std::vector<double>),
+            ! isNumberListType(last_option->type),
             "Cannot add a new positional argument after one with a list type"
         );
         assert_message(
@@ -504,7 +1584,330 @@ auto yeschief::CLI::parsePositional(const std::string &option_name, Tail &&...op
     }
 
     _positional_options.push_back(option_name);
+    _help.invalidate();
+    _fingerprint.invalidate();
     parsePositional(std::forward<Tail>(options)...);
 }
 
+namespace yeschief {
+constexpr auto appendUpper(std::string &out, const std::string_view str) -> void {
+    for (const auto c : str) {
+        out += c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+}
+
+/**
+ * @return Count of columns a terminal uses to display code_point: 0 for combining marks, 2 for wide characters (CJK,
+ * Hangul, fullwidth forms, emojis), else 1
+ */
+constexpr auto codePointWidth(const char32_t code_point) -> size_t {
+    if ((code_point >= 0x0300 && code_point <= 0x036F) || (code_point >= 0x200B && code_point <= 0x200F)
+        || (code_point >= 0xFE00 && code_point <= 0xFE0F)) {
+        return 0;
+    }
+    if ((code_point >= 0x1100 && code_point <= 0x115F) || (code_point >= 0x2E80 && code_point <= 0xA4CF)
+        || (code_point >= 0xAC00 && code_point <= 0xD7A3) || (code_point >= 0xF900 && code_point <= 0xFAFF)
+        || (code_point >= 0xFE30 && code_point <= 0xFE4F) || (code_point >= 0xFF00 && code_point <= 0xFF60)
+        || (code_point >= 0xFFE0 && code_point <= 0xFFE6) || (code_point >= 0x1F300 && code_point <= 0x1F64F)
+        || (code_point >= 0x1F900 && code_point <= 0x1F9FF) || (code_point >= 0x20000 && code_point <= 0x3FFFD)) {
+        return 2;
+    }
+
+    return 1;
+}
+
+/**
+ * Decode the code point starting at index of text and add its width to width
+ *
+ * @return Count of bytes of the code point
+ */
+constexpr auto appendCodePointWidth(size_t &width, const std::string_view text, const size_t index) -> size_t {
+    const auto lead = static_cast<unsigned char>(text[index]);
+    if (lead < 0x80) {
+        width++;
+        return 1;
+    }
+    if (lead < 0xC0) {
+        return 1;
+    }
+
+    size_t length       = 2;
+    char32_t code_point = lead & 0x1F;
+    if (lead >= 0xF0) {
+        length     = 4;
+        code_point = lead & 0x07;
+    } else if (lead >= 0xE0) {
+        length     = 3;
+        code_point = lead & 0x0F;
+    }
+    if (length > text.size() - index) {
+        width++;
+        return 1;
+    }
+    for (size_t byte = 1; byte < length; byte++) {
+        code_point = (code_point << 6) | (static_cast<unsigned char>(text[index + byte]) & 0x3F);
+    }
+    width += codePointWidth(code_point);
+
+    return length;
+}
+
+/**
+ * @return Count of columns a terminal uses to display the UTF-8 text. Text is read 8 bytes at a time while they hold
+ * only characters 1 column wide (ASCII and most 2 bytes ones), other code points are decoded one by one. A truncated
+ * sequence counts for 1 column, a stray continuation byte for none
+ */
+constexpr auto displayWidth(const std::string_view text) -> size_t {
+    constexpr uint64_t high_bits = 0x8080808080808080;
+    constexpr uint64_t low_bits  = 0x7F7F7F7F7F7F7F7F;
+    // Added to the low 7 bits of each byte, it carries into the high bit from 0x4C: bytes from 0xCC start combining
+    // marks or characters of 3 or 4 bytes, which may not be 1 column wide
+    constexpr uint64_t from_0xcc = 0x3434343434343434;
+
+    size_t width = 0;
+    size_t i     = 0;
+    while (text.size() - i >= 8) {
+        uint64_t word = 0;
+        if consteval {
+            for (size_t byte = 0; byte < 8; byte++) {
+                word |= static_cast<uint64_t>(static_cast<unsigned char>(text[i + byte])) << (8 * byte);
+            }
+        } else {
+            std::memcpy(&word, text.data() + i, sizeof(word));
+        }
+
+        if ((word & high_bits) == 0) {
+            width += 8;
+            i += 8;
+            continue;
+        }
+        if ((word & ((word & low_bits) + from_0xcc) & high_bits) == 0) {
+            // Continuation bytes (0b10xxxxxx) belong to a character already counted
+            const auto continuations = word & ~(word << 1) & high_bits;
+            width += 8 - static_cast<size_t>(std::popcount(continuations));
+            i += 8;
+            continue;
+        }
+
+        i += appendCodePointWidth(width, text, i);
+    }
+    while (i < text.size()) {
+        i += appendCodePointWidth(width, text, i);
+    }
+
+    return width;
+}
+
+/**
+ * Append line to out. With a width, words are wrapped so that no line, indent included, is wider than it. A single word
+ * wider than the available space keeps its own line
+ *
+ * @param width Count of columns available, 0 to not wrap
+ */
+constexpr auto appendWrappedLine(
+    std::string &out, const std::string_view line, const std::string_view indent, const size_t width
+) -> void {
+    const auto available = width > indent.size() ? width - indent.size() : 1;
+    if (width == 0 || displayWidth(line) <= available) {
+        out += line;
+        return;
+    }
+
+    size_t column = 0;
+    size_t start  = 0;
+    while (start < line.size()) {
+        const auto end  = std::min(line.find(' ', start), line.size());
+        const auto word = line.substr(start, end - start);
+        start           = end + 1;
+        if (word.empty()) {
+            continue;
+        }
+
+        const auto word_width = displayWidth(word);
+        if (column > 0 && column + 1 + word_width > available) {
+            out += '\n';
+            out += indent;
+            column = 0;
+        }
+        if (column > 0) {
+            out += ' ';
+            column++;
+        }
+        out += word;
+        column += word_width;
+    }
+}
+
+/**
+ * Append the non empty lines of text to out, separated by a new line and indent
+ *
+ * @param width Count of columns lines are wrapped to, indent included. 0 to not wrap them
+ */
+constexpr auto appendIndentedLines(
+    std::string &out, const std::string_view text, const std::string_view indent, const size_t width = 0
+) -> void {
+    bool first   = true;
+    size_t start = 0;
+    while (start <= text.size()) {
+        const auto end  = std::min(text.find('\n', start), text.size());
+        const auto line = text.substr(start, end - start);
+        if (! line.empty()) {
+            if (! first) {
+                out += '\n';
+                out += indent;
+            }
+            appendWrappedLine(out, line, indent, width);
+            first = false;
+        }
+        start = end + 1;
+    }
+}
+
+constexpr auto findStaticOption(const StaticSchema &schema, const std::string_view name) -> const StaticOption * {
+    for (const auto &option : schema.options) {
+        if (option.name == name) {
+            return &option;
+        }
+    }
+
+    return nullptr;
+}
+
+constexpr auto appendOptionUsageHelp(std::string &out, const StaticOption &option) -> void {
+    const auto append_value_help = [&] {
+        if (option.type != OptionType::Boolean) {
+            out += ' ';
+            out += option.value_help;
+        }
+    };
+
+    out += "--";
+    out += option.name;
+    append_value_help();
+    if (! option.short_name.empty()) {
+        out += ", -";
+        out += option.short_name;
+        append_value_help();
+    }
+    if (option.required) {
+        out += " [REQUIRED]";
+    }
+}
+
+constexpr auto appendPositionalHelp(std::string &out, const StaticSchema &schema, const size_t width) -> void {
+    if (schema.positional.empty()) {
+        return;
+    }
+
+    out += "Positional arguments:\n"
+           "\n"
+           "  These arguments come after options and in the order they are listed here.\n";
+
+    if (findStaticOption(schema, schema.positional[0])->required) {
+        out += "  Only ";
+        size_t required_count = 0;
+        for (const auto name : schema.positional) {
+            if (! findStaticOption(schema, name)->required) {
+                break;
+            }
+            if (required_count > 0) {
+                out += ", ";
+            }
+            appendUpper(out, name);
+            required_count++;
+        }
+        out += required_count == 1 ? " is required.\n\n" : " are required.\n\n";
+    }
+
+    for (const auto name : schema.positional) {
+        out += "  ";
+        appendUpper(out, name);
+        const auto option = findStaticOption(schema, name);
+        if (option->required) {
+            out += " [REQUIRED]";
+        }
+        out += "\n    ";
+        appendIndentedLines(out, option->description, "    ", width);
+        out += "\n\n";
+    }
+}
+} // namespace yeschief
+
+constexpr auto yeschief::renderUsageHelp(const StaticSchema &schema) -> std::string {
+    std::string usage(schema.name);
+    if (! schema.options.empty()) {
+        usage += " [OPTIONS]";
+    }
+
+    // In name order, as CLI keeps its options
+    std::vector<std::string_view> required;
+    for (const auto &option : schema.options) {
+        if (option.required && std::ranges::find(schema.positional, option.name) == schema.positional.end()) {
+            required.push_back(option.name);
+        }
+    }
+    std::ranges::sort(required);
+    for (const auto name : required) {
+        usage += " --";
+        usage += name;
+    }
+
+    for (const auto name : schema.positional) {
+        if (findStaticOption(schema, name)->required) {
+            usage += ' ';
+            appendUpper(usage, name);
+        } else {
+            usage += " [";
+            appendUpper(usage, name);
+            usage += ']';
+        }
+    }
+
+    return usage;
+}
+
+constexpr auto yeschief::renderHelp(const StaticSchema &schema, const size_t width) -> std::string {
+    std::string help = "usage:\n  ";
+    help += renderUsageHelp(schema);
+    help += "\n\n";
+    help += schema.description;
+    help += "\n\n";
+    appendPositionalHelp(help, schema, width);
+
+    // In name order, as CLI keeps its groups
+    std::vector<std::string_view> groups;
+    for (const auto &option : schema.options) {
+        if (std::ranges::find(groups, option.group) == groups.end()) {
+            groups.push_back(option.group);
+        }
+    }
+    std::ranges::sort(groups);
+    for (const auto group : groups) {
+        help += group.empty() ? "Options" : group;
+        help += ":\n\n";
+        for (const auto &option : schema.options) {
+            if (option.group != group) {
+                continue;
+            }
+            help += "  ";
+            appendOptionUsageHelp(help, option);
+            help += "\n    ";
+            appendIndentedLines(help, option.description, "    ", width);
+            help += "\n\n";
+        }
+    }
+
+    return help;
+}
+
+template<const yeschief::StaticSchema &schema, size_t width>
+constexpr auto yeschief::staticHelp() {
+    constexpr auto size = renderHelp(schema, width).size();
+    std::array<char, size> help{};
+    const auto rendered = renderHelp(schema, width);
+    std::ranges::copy(rendered, help.begin());
+
+    return help;
+}
+
 #endif // YESCHIEF_H
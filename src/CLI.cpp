@@ -24,23 +24,198 @@
 #include "utils.h"
 #include "yeschief.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <ranges>
-#include <regex>
-#include <typeindex>
+#include <thread>
 #include <utility>
 
 using namespace yeschief;
 
+/**
+ * Count of argument lists a thread claims at once in `CLI::runBatch`
+ */
+constexpr size_t BATCH_CHUNK_SIZE = 64;
+
+/**
+ * Count of values a thread claims at once when converting a list in parallel
+ */
+constexpr size_t PARALLEL_CONVERSION_CHUNK_SIZE = 4096;
+
+/**
+ * Hidden switch printing the profile of a run on STDERR
+ */
+constexpr std::string_view PROFILE_SWITCH = "--yeschief-profile";
+
+/**
+ * Hidden switch printing completion candidates of the following arguments, see `CLI::complete`
+ */
+constexpr std::string_view COMPLETE_SWITCH = "__complete";
+
+namespace {
+/**
+ * Remove `--yeschief-profile` from argv when it is its first argument. Only the entry points of the program look for
+ * it, so that a CLI parsing arguments of others never prints anything
+ *
+ * @return Whether it was given
+ */
+auto takeProfileSwitch(int &argc, char **&argv) -> bool {
+    if (argc < 2 || argv[1] != PROFILE_SWITCH) {
+        return false;
+    }
+    argc--;
+    argv++;
+
+    return true;
+}
+
+/**
+ * Profile a run when the CLI has a profiler or when print is set, the profile is then printed on STDERR too. A run
+ * nested in an already profiled one (a command CLI) adds to the profile of its parent instead
+ */
+class ProfileSession final {
+  public:
+    ProfileSession(Profiler *profiler, const bool print, RunProfile *&current)
+        : _profiler(profiler), _current(current), _print(print) {
+        if (current != nullptr || (_profiler == nullptr && ! _print)) {
+            return;
+        }
+        _owner  = true;
+        current = &_profile;
+        _start  = std::chrono::steady_clock::now();
+    }
+
+    ProfileSession(const ProfileSession &)                    = delete;
+    auto operator=(const ProfileSession &) -> ProfileSession & = delete;
+
+    ~ProfileSession() {
+        if (! _owner) {
+            return;
+        }
+        _current       = nullptr;
+        _profile.total = std::chrono::steady_clock::now() - _start - _profile.command;
+        if (_profiler != nullptr) {
+            _profiler->record(_profile);
+        }
+        if (_print) {
+            printProfile(_profile, std::cerr);
+        }
+    }
+
+  private:
+    Profiler *_profiler;
+    RunProfile *&_current;
+    RunProfile _profile;
+    bool _print;
+    bool _owner = false;
+    std::chrono::steady_clock::time_point _start;
+};
+} // namespace
+
 CLI::CLI(std::string name, std::string description)
     : _name(std::move(name)), _description(std::move(description)), _mode(std::nullopt) {
     _groups.emplace("", OptionGroup(this, ""));
 }
 
+CLI::CLI(const StaticSchema &schema): CLI(std::string(schema.name), std::string(schema.description)) {
+    for (const auto &option : schema.options) {
+        const std::string group(option.group);
+        if (! _groups.contains(group)) {
+            _groups.emplace(group, OptionGroup(this, group));
+        }
+
+        auto name = std::string(option.name);
+        if (! option.short_name.empty()) {
+            name += ",";
+            name += option.short_name;
+        }
+        const std::string description(option.description);
+        OptionConfiguration configuration;
+        configuration.required   = option.required;
+        configuration.value_help = std::string(option.value_help);
+        configuration.env        = std::string(option.env);
+
+        switch (option.type) {
+            case OptionType::Boolean:
+                addOption<bool>(name, description, group, configuration);
+                break;
+            case OptionType::String:
+                addOption<std::string>(name, description, group, configuration);
+                break;
+            case OptionType::Int:
+                addOption<int>(name, description, group, configuration);
+                break;
+            case OptionType::Float:
+                addOption<float>(name, description, group, configuration);
+                break;
+            case OptionType::Double:
+                addOption<double>(name, description, group, configuration);
+                break;
+            case OptionType::BooleanList:
+                addOption<std::vector<bool>>(name, description, group, configuration);
+                break;
+            case OptionType::StringList:
+                addOption<std::vector<std::string>>(name, description, group, configuration);
+                break;
+            case OptionType::IntList:
+                addOption<std::vector<int>>(name, description, group, configuration);
+                break;
+            case OptionType::FloatList:
+                addOption<std::vector<float>>(name, description, group, configuration);
+                break;
+            case OptionType::DoubleList:
+                addOption<std::vector<double>>(name, description, group, configuration);
+                break;
+        }
+    }
+
+    for (const auto name : schema.positional) {
+        parsePositional(std::string(name));
+    }
+}
+
+auto CLI::setProfiler(Profiler *profiler) -> CLI & {
+    _profiler = profiler;
+    return *this;
+}
+
+auto CLI::setParallelConversionThreshold(const size_t threshold) -> CLI & {
+    _parallel_conversion_threshold = threshold;
+    return *this;
+}
+
+auto CLI::setHelpWidth(const size_t width) -> CLI & {
+    _help_width = width;
+    for (auto &command_cli : _commands_cli | std::ranges::views::values) {
+        command_cli.setHelpWidth(width);
+    }
+    _help.invalidate();
+    return *this;
+}
+
+auto CLI::setPrefixMatching(const bool enabled) -> CLI & {
+    _prefix_matching = enabled;
+    for (auto &command_cli : _commands_cli | std::ranges::views::values) {
+        command_cli.setPrefixMatching(enabled);
+    }
+    return *this;
+}
+
+auto CLI::setConfigFile(const ConfigFile *file) -> CLI & {
+    _config_file = file;
+    for (auto &command_cli : _commands_cli | std::ranges::views::values) {
+        command_cli.setConfigFile(file);
+    }
+    return *this;
+}
+
 auto CLI::addGroup(const std::string &name) -> OptionGroup & {
     assert_message(
         ! _mode.has_value() || _mode.value() != Mode::COMMANDS, "Cannot add an option group to a cli using commands"
     );
     _mode = Mode::OPTIONS;
+    _help.invalidate();
 
     assert_message(! _groups.contains(name), "Group already exists");
 
@@ -52,11 +227,18 @@ auto CLI::addCommand(Command *command) -> CLI & {
         ! _mode.has_value() || _mode.value() != Mode::OPTIONS, "Cannot add a command to a cli using options"
     );
     _mode = Mode::COMMANDS;
+    _help.invalidate();
+    _command_prefixes.invalidate();
+    _fingerprint.invalidate();
 
     const auto name = command->getName();
     assert_message(! _commands.contains(name), "Command already exists");
 
     CLI command_cli(name, command->getDescription());
+    command_cli._help_width      = _help_width;
+    command_cli._prefix_matching = _prefix_matching;
+    command_cli._config_file     = _config_file;
+    command_cli._config_section  = _config_section.empty() ? name : _config_section + "." + name;
     command->setup(command_cli);
 
     _commands.emplace(name, command);
@@ -65,374 +247,871 @@ auto CLI::addCommand(Command *command) -> CLI & {
     return *this;
 }
 
-auto CLI::run(const int argc, char **argv) const -> std::expected<CLIResults, Fault> {
-    if (argc < 1) {
-        return std::unexpected<Fault>({
-          .message = "argc cannot be less than 1, argv should at least contains executable name",
-          .type    = FaultType::InvalidArgs,
-        });
-    }
-
+auto CLI::run(int argc, char **argv) const -> std::expected<CLIResults, Fault> {
     if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
-        auto count     = argc - 1;
-        auto arguments = argv + 1;
-        if (count == 0) {
-            auto results = CLIResults({});
-            return results;
-        }
-
-        const std::string command_name(arguments[0]);
-        if (! _commands.contains(command_name)) {
-            return std::unexpected<Fault>({
-              .message = "Command '" + command_name + "' not found",
-              .type    = FaultType::UnknownCommand,
-            });
+        const auto exit_code = runCommand(argc, argv);
+        if (! exit_code.has_value()) {
+            return std::unexpected(exit_code.error());
         }
-        auto command       = _commands.at(command_name);
-        auto cli           = _commands_cli.at(command_name);
-        const auto results = cli.run(count, arguments);
-        if (! results.has_value()) {
-            return std::unexpected(results.error());
+        if (! exit_code.value().has_value()) {
+            return CLIResults({});
         }
-        exit(command->run(results.value()));
+        exit(exit_code.value().value());
+    }
+    if (argc > 1 && argv[1] == COMPLETE_SWITCH) {
+        printCompletion(std::span<char *const>(argv + 2, static_cast<size_t>(argc - 2)));
+        // As when running a command, run has no exit code to return: answering completion ends the program
+        exit(0);
     }
 
-    std::vector<std::string> allowed_options;
-    for (const auto &option : _options | std::ranges::views::values) {
-        allowed_options.push_back(option->name);
-        allowed_options.push_back(option->short_name);
+    ParseContext context;
+    const auto print_profile = takeProfileSwitch(argc, argv);
+    const ProfileSession session(_profiler, print_profile, context._profile);
+    if (const auto results = run(argc, argv, context); ! results.has_value()) {
+        auto fault = results.error();
+        // Located in argv without the profile switch
+        if (print_profile && fault.argument_index.has_value()) {
+            fault.argument_index.value()++;
+        }
+        return std::unexpected(std::move(fault));
     }
-    const auto parse_results_expect = parseArgv(argc - 1, argv + 1, allowed_options);
-    if (! parse_results_expect.has_value()) {
-        return std::unexpected(parse_results_expect.error());
+
+    return std::move(context._results);
+}
+
+auto CLI::run(const int argc, char **argv, std::pmr::memory_resource *resource) const
+    -> std::expected<CLIResults, Fault> {
+    ParseContext context(resource);
+    const auto results = run(argc, argv, context);
+    if (! results.has_value()) {
+        return std::unexpected(results.error());
     }
-    const auto &[raw_results, option_order, positional_arguments] = parse_results_expect.value();
-    std::map<std::string, std::any> option_values;
-    std::vector<std::string> missing_required;
 
-    if (_positional_options.empty() && ! positional_arguments.empty()) {
-        return std::unexpected<Fault>({
-          .message = "Unrecognized option: " + positional_arguments[0],
-          .type    = FaultType::UnrecognizedOption,
-        });
+    return std::move(context._results);
+}
+
+auto CLI::run(const int argc, char **argv, ParseContext &context) const
+    -> std::expected<std::reference_wrapper<const CLIResults>, Fault> {
+    if (argc < 1) {
+        return std::unexpected<Fault>({.type = FaultType::InvalidArgs});
     }
-    size_t positional_index = 0;
-    for (const auto &option_name : _positional_options) {
-        if (positional_index == positional_arguments.size()) {
-            break;
+
+    context.clear();
+
+    if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+        const auto exit_code = runCommand(argc, argv, context);
+        if (! exit_code.has_value()) {
+            return std::unexpected(exit_code.error());
         }
+        if (! exit_code.value().has_value()) {
+            return std::cref(context._results);
+        }
+        exit(exit_code.value().value());
+    }
 
-        const auto option       = _options.at(option_name);
-        const auto &option_type = option->type;
+    return parseArguments(argc, argv, context);
+}
 
-        if (option_type == typeid(std::vector<int>) || option_type == typeid(std::vector<float>)
-            || option_type == typeid(std::vector<double>)) {
-            auto values = std::vector(positional_arguments.begin() + positional_index, positional_arguments.end());
-            auto value  = getValueForOption(option, values);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
+auto CLI::parseArguments(const int argc, char **argv, ParseContext &context) const
+    -> std::expected<std::reference_wrapper<const CLIResults>, Fault> {
+    const std::span<char *const> arguments(argv + 1, static_cast<size_t>(argc - 1));
+    const auto fail = [this, &arguments](Fault fault) -> std::unexpected<Fault> {
+        locateArgument(fault, arguments, 1);
+        fault.cli = this;
+        return std::unexpected(std::move(fault));
+    };
+
+    const ProfileSession session(_profiler, false, context._profile);
+    auto &state                   = *context._state;
+    const std::function is_option = [this](const std::string_view name) {
+        return hasOption(name);
+    };
+    const std::function prefixes = [this] {
+        return optionPrefixes();
+    };
+    {
+        PhaseTimer timer(context._profile, ProfilePhase::Tokenize);
+        for (int i = 1; i < argc; i++) {
+            if (const auto result = parseArgument(argv[i], is_option, state, prefixes); ! result.has_value()) {
+                return fail(result.error());
             }
-            option_values.emplace(option_name, value.value());
-            break;
         }
+        endParsing(state);
+    }
+    if (context._profile != nullptr) {
+        context._profile->tokens += argc - 1;
+    }
 
-        auto value = getValueForOption(option, {positional_arguments[positional_index]});
-        if (! value.has_value()) {
-            return std::unexpected(value.error());
+    if (const auto result = buildResults(state.result, context); ! result.has_value()) {
+        return fail(result.error());
+    }
+
+    return std::cref(context._results);
+}
+
+auto CLI::runCollectingFaults(const int argc, char **argv) const -> std::expected<CLIResults, std::vector<Fault>> {
+    assert_message(
+        ! _mode.has_value() || _mode.value() != Mode::COMMANDS, "Cannot collect faults on a cli using commands"
+    );
+    if (argc < 1) {
+        return std::unexpected(std::vector<Fault>{{.type = FaultType::InvalidArgs}});
+    }
+
+    ParseContext context;
+    auto &state                   = *context._state;
+    const std::function is_option = [this](const std::string_view name) {
+        return hasOption(name);
+    };
+    const std::function prefixes = [this] {
+        return optionPrefixes();
+    };
+    std::vector<Fault> faults;
+    for (int i = 1; i < argc; i++) {
+        if (auto result = parseArgument(argv[i], is_option, state, prefixes); ! result.has_value()) {
+            faults.push_back(std::move(result.error()));
         }
-        option_values.emplace(option_name, value.value());
+    }
+    endParsing(state);
+    (void) buildResults(state.result, context, &faults);
 
-        positional_index++;
+    if (faults.empty()) {
+        return std::move(context._results);
     }
 
-    for (const auto &option : _options | std::ranges::views::values) {
-        const auto long_raw_values  = raw_results.find(option->name);
-        const auto short_raw_values = raw_results.find(option->short_name);
-        if (long_raw_values != raw_results.end() && short_raw_values != raw_results.end()) {
-            auto long_values_it  = long_raw_values->second.begin();
-            auto short_values_it = short_raw_values->second.begin();
-            std::vector<std::string> values;
-            // Assert that long_values.length + short_values.length === option_orders of (-n, --name).
-            // If it is not the case it means there is a bug in parseArgv and it should be fixed
-            for (const auto &oo : option_order) {
-                if (oo == option->name) {
-                    values.push_back(*long_values_it++);
-                } else if (oo == option->short_name) {
-                    values.push_back(*short_values_it++);
+    const std::span<char *const> arguments(argv + 1, static_cast<size_t>(argc - 1));
+    for (auto &fault : faults) {
+        locateArgument(fault, arguments, 1);
+        fault.cli = this;
+    }
+    std::ranges::stable_sort(faults, [](const Fault &a, const Fault &b) {
+        return a.argument_index.has_value() && (! b.argument_index.has_value() || a.argument_index < b.argument_index);
+    });
+    // Options given after positional arguments all report the first of them, once is enough
+    const auto duplicates = std::ranges::unique(faults, [](const Fault &a, const Fault &b) {
+        return a.type == b.type && ! a.token.empty() && a.token.data() == b.token.data();
+    });
+    faults.erase(duplicates.begin(), duplicates.end());
+
+    return std::unexpected(std::move(faults));
+}
+
+auto CLI::runBatch(const std::span<const std::vector<std::string>> argvs, unsigned thread_count) const
+    -> std::vector<std::expected<CLIResults, Fault>> {
+    assert_message(
+        ! _mode.has_value() || _mode.value() != Mode::COMMANDS, "Cannot run a batch on a cli using commands"
+    );
+    if (thread_count == 0) {
+        thread_count = std::max(1U, std::thread::hardware_concurrency());
+    }
+
+    std::vector<std::expected<CLIResults, Fault>> results(argvs.size(), std::unexpected(Fault{}));
+    std::vector<ParseContext> contexts(thread_count);
+    std::vector<std::vector<char *>> arguments(thread_count);
+    parallelFor(
+        argvs.size(),
+        thread_count,
+        BATCH_CHUNK_SIZE,
+        [&](const unsigned thread_index, const size_t begin, const size_t end) {
+            auto &context = contexts[thread_index];
+            auto &argv    = arguments[thread_index];
+            for (auto i = begin; i < end; i++) {
+                argv.clear();
+                for (const auto &argument : argvs[i]) {
+                    argv.push_back(const_cast<char *>(argument.c_str()));
                 }
-            }
-            auto value = getValueForOption(option, values);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
-            }
-            option_values.emplace(option->name, value.value());
-        }
 
-        else if (long_raw_values != raw_results.end()) {
-            auto values = raw_results.at(option->name);
-            auto value  = getValueForOption(option, values);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
+                const auto result = run(static_cast<int>(argv.size()), argv.data(), context);
+                if (result.has_value()) {
+                    results[i] = result.value().get();
+                } else {
+                    results[i] = std::unexpected(result.error());
+                }
             }
-            option_values.emplace(option->name, value.value());
         }
+    );
 
-        else if (short_raw_values != raw_results.end()) {
-            auto values = raw_results.at(option->short_name);
-            auto value  = getValueForOption(option, values);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
-            }
-            option_values.emplace(option->name, value.value());
+    return results;
+}
+
+auto CLI::runCommand(int argc, char **argv) const -> std::expected<std::optional<int>, Fault> {
+    if (argc > 1 && argv[1] == COMPLETE_SWITCH) {
+        printCompletion(std::span<char *const>(argv + 2, static_cast<size_t>(argc - 2)));
+        return 0;
+    }
+
+    ParseContext context;
+    const auto print_profile = takeProfileSwitch(argc, argv);
+    const ProfileSession session(_profiler, print_profile, context._profile);
+    auto exit_code = runCommand(argc, argv, context);
+    // Located in argv without the profile switch
+    if (print_profile && ! exit_code.has_value() && exit_code.error().argument_index.has_value()) {
+        exit_code.error().argument_index.value()++;
+    }
+
+    return exit_code;
+}
+
+auto CLI::runCommand(const int argc, char **argv, ParseContext &context) const
+    -> std::expected<std::optional<int>, Fault> {
+    assert_message(
+        ! _mode.has_value() || _mode.value() == Mode::COMMANDS, "Cannot run a command of a cli using options"
+    );
+    if (argc < 1) {
+        return std::unexpected<Fault>({.type = FaultType::InvalidArgs});
+    }
+
+    context.clear();
+
+    return dispatchCommand(argc, argv, context);
+}
+
+auto CLI::dispatchCommand(const int argc, char **argv, ParseContext &context) const
+    -> std::expected<std::optional<int>, Fault> {
+    const ProfileSession session(_profiler, false, context._profile);
+    const auto count     = argc - 1;
+    const auto arguments = argv + 1;
+    if (count == 0) {
+        return std::nullopt;
+    }
+    // Faults of the command CLI are located in its own arguments
+    constexpr size_t offset = 1;
+    const auto fail         = [](Fault fault) -> std::unexpected<Fault> {
+        if (fault.argument_index.has_value()) {
+            fault.argument_index.value() += offset;
         }
+        return std::unexpected(std::move(fault));
+    };
 
-        else if (option->configuration.default_value.has_value()) {
-            option_values.emplace(option->name, option->configuration.default_value.value());
+    // Command execution is not part of the profile
+    const auto run_command = [&context](Command *command, const CLIResults &results) -> int {
+        if (context._profile == nullptr) {
+            return command->run(results);
         }
+        const auto start  = std::chrono::steady_clock::now();
+        const auto result = command->run(results);
+        context._profile->command += std::chrono::steady_clock::now() - start;
 
-        else if (option->configuration.required && ! option_values.contains(option->name)) {
-            missing_required.push_back(option->name);
+        return result;
+    };
+
+    std::optional<PhaseTimer> timer(std::in_place, context._profile, ProfilePhase::CommandDispatch);
+    const auto command_name = resolveCommand(arguments[0]);
+    if (! command_name.has_value()) {
+        auto fault           = command_name.error();
+        fault.token          = arguments[0];
+        fault.argument_index = offset;
+        return std::unexpected(std::move(fault));
+    }
+    const auto command = _commands.find(command_name.value());
+    if (const auto read = readConfigFile(context, [](Fault &&) { return false; }); ! read.has_value()) {
+        return std::unexpected(read.error());
+    }
+
+    const auto &cli = _commands_cli.find(command_name.value())->second;
+    timer.reset();
+    if (context._profile != nullptr) {
+        context._profile->tokens++;
+    }
+    if (cli._mode.has_value() && cli._mode.value() == Mode::COMMANDS) {
+        const auto exit_code = cli.dispatchCommand(count, arguments, context);
+        if (! exit_code.has_value()) {
+            return fail(exit_code.error());
         }
+        if (exit_code.value().has_value()) {
+            return exit_code;
+        }
+        return run_command(command->second, context._results);
     }
 
-    if (! missing_required.empty()) {
-        return std::unexpected<Fault>({
-          .message = "Some required options were not given: " + join(missing_required, ", "),
-          .type    = FaultType::MissingRequiredOption,
-        });
+    const auto results = cli.parseArguments(count, arguments, context);
+    if (! results.has_value()) {
+        return fail(results.error());
     }
 
-    CLIResults results(option_values);
-    return results;
+    return run_command(command->second, results.value());
 }
 
-template<typename T> auto toAny(std::expected<T, Fault> exp) -> std::expected<std::any, Fault> {
-    return exp.transform([](const auto &value) {
-        return std::any(value);
+auto CLI::fingerprint() const -> uint64_t {
+    return _fingerprint.get([this] {
+        // Names cannot contain null characters, they end each of them
+        std::string schema;
+        for (const auto &option : _options | std::views::values) {
+            schema += option->name;
+            schema += '\0';
+            schema += option->short_name;
+            schema += '\0';
+            schema += static_cast<char>(option->type);
+        }
+        schema += '\0';
+        for (const auto &name : _positional_options) {
+            schema += name;
+            schema += '\0';
+        }
+        schema += '\0';
+        for (const auto &[name, command_cli] : _commands_cli) {
+            schema += name;
+            schema += '\0';
+            const auto command_fingerprint = command_cli.fingerprint();
+            schema.append(reinterpret_cast<const char *>(&command_fingerprint), sizeof(command_fingerprint));
+        }
+
+        return hashBytes(schema);
     });
 }
 
-auto CLI::getValueForOption(const std::shared_ptr<const Option> &option, const std::vector<std::string> &values)
-    -> std::expected<std::any, Fault> {
-    const auto last_index = values.size() - 1;
-    if (option->type == typeid(bool)) {
-        return toAny(toBoolean(values[last_index]));
+auto CLI::findOption(const std::string_view name) const -> std::shared_ptr<const Option> {
+    if (const auto option = _options.find(name); option != _options.end()) {
+        return option->second;
+    }
+    if (const auto option = _short_options.find(name); option != _short_options.end()) {
+        return option->second;
     }
 
-    if (values.size() == 1 && values[0] == "true") {
-        if (option->configuration.implicit_value.has_value()) {
-            return option->configuration.implicit_value.value();
-        } else {
-            return std::unexpected<Fault>({
-              .message = "Option '" + option->name + "' needs a value",
-              .type    = FaultType::MissingOptionValue,
-            });
+    return nullptr;
+}
+
+auto CLI::hasOption(const std::string_view name) const -> bool {
+    return _options.contains(name) || _short_options.contains(name);
+}
+
+auto CLI::resolveOption(const std::string_view name) const -> std::shared_ptr<const Option> {
+    if (auto option = findOption(name); option != nullptr) {
+        return option;
+    }
+
+    if (const auto *index = optionPrefixes(); index != nullptr && ! name.empty()) {
+        if (const auto names = index->find(name); names.size() == 1) {
+            return _options.find(names.front())->second;
         }
     }
 
-    if (option->type == typeid(std::string)) {
-        return values[last_index];
+    return nullptr;
+}
+
+auto CLI::optionPrefixes() const -> const PrefixIndex * {
+    if (! _prefix_matching) {
+        return nullptr;
     }
-    if (option->type == typeid(int)) {
-        return toAny(toInt(values[last_index]));
+
+    return _option_prefixes
+        .get([this] {
+            return std::make_shared<const PrefixIndex>(_options | std::views::keys);
+        })
+        .get();
+}
+
+auto CLI::resolveCommand(const std::string_view name) const -> std::expected<std::string_view, Fault> {
+    if (const auto command = _commands.find(name); command != _commands.end()) {
+        return command->first;
     }
-    if (option->type == typeid(float)) {
-        return toAny(toFloat(values[last_index]));
+
+    if (_prefix_matching && ! name.empty()) {
+        const auto &index = _command_prefixes.get([this] {
+            return std::make_shared<const PrefixIndex>(_commands | std::views::keys);
+        });
+        if (const auto names = index->find(name); names.size() == 1) {
+            return names.front();
+        } else if (names.size() > 1) {
+            return std::unexpected<Fault>({
+              .type       = FaultType::AmbiguousPrefix,
+              .candidates = {names.begin(), names.end()},
+              .cli        = this,
+            });
+        }
     }
-    if (option->type == typeid(double)) {
-        return toAny(toDouble(values[last_index]));
+
+    return std::unexpected<Fault>({.type = FaultType::UnknownCommand, .cli = this});
+}
+
+auto CLI::readConfigFile(ParseContext &context, const std::function<bool(Fault &&)> &keep_going) const
+    -> std::expected<void, Fault> {
+    if (_config_file == nullptr) {
+        return {};
     }
-    if (option->type == typeid(std::vector<bool>)) {
-        std::vector<bool> bool_results;
-        bool_results.reserve(values.size());
-        for (const auto &string_value : values) {
-            const auto value = toBoolean(string_value);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
+
+    auto &entries = context._config_entries;
+    if (! context._config_read) {
+        context._config_read = true;
+        const auto read      = scanConfig(
+            _config_file->content(),
+            [&entries](const std::string_view section, const std::string_view key, const std::string_view value)
+                -> std::expected<void, Fault> {
+                entries.push_back({.section = section, .key = key, .value = value});
+                return {};
             }
-            bool_results.push_back(value.value());
+        );
+        if (! read.has_value()) {
+            context._config_fault = read.error();
         }
-        return bool_results;
-    }
-    if (option->type == typeid(std::vector<std::string>)) {
-        return values;
     }
-    if (option->type == typeid(std::vector<int>)) {
-        std::vector<int> int_results;
-        int_results.reserve(values.size());
-        for (const auto &string_value : values) {
-            const auto value = toInt(string_value);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
+
+    auto &config_values = context._config_values;
+    config_values.clear();
+    for (const auto &[section, key, value] : entries) {
+        if (! key.empty()) {
+            if (section != _config_section) {
+                continue;
+            }
+            if (const auto option = _options.find(key); option != _options.end()) {
+                config_values.emplace_back(option->second->name, value);
+            } else if (Fault fault = {
+                           .type   = FaultType::UnrecognizedOption,
+                           .token  = key,
+                           .source = TokenSource::ConfigFile,
+                           .cli    = this,
+                       };
+                       ! keep_going(std::move(fault))) {
+                return std::unexpected(std::move(fault));
             }
-            int_results.push_back(value.value());
+            continue;
+        }
+
+        // Only sections of the commands of this CLI are its business, the ones of sub commands are checked by them
+        if (section == _config_section
+            || (! _config_section.empty()
+                && (! section.starts_with(_config_section) || section.size() <= _config_section.size()
+                    || section[_config_section.size()] != '.'))) {
+            continue;
+        }
+        const auto subsection = section.substr(_config_section.empty() ? 0 : _config_section.size() + 1);
+        const auto command    = subsection.substr(0, subsection.find('.'));
+        if (_commands.contains(command)) {
+            continue;
+        }
+        if (Fault fault = {
+                .type   = FaultType::UnknownCommand,
+                .token  = command,
+                .source = TokenSource::ConfigFile,
+                .cli    = this,
+            };
+            ! keep_going(std::move(fault))) {
+            return std::unexpected(std::move(fault));
         }
-        return int_results;
     }
-    if (option->type == typeid(std::vector<float>)) {
-        std::vector<float> float_results;
-        float_results.reserve(values.size());
-        for (const auto &string_value : values) {
-            const auto value = toFloat(string_value);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
-            }
-            float_results.push_back(value.value());
+    if (context._config_fault.has_value()) {
+        if (auto fault = context._config_fault.value(); ! keep_going(std::move(fault))) {
+            return std::unexpected(context._config_fault.value());
         }
-        return float_results;
     }
-    if (option->type == typeid(std::vector<double>)) {
-        std::vector<double> double_results;
-        double_results.reserve(values.size());
-        for (const auto &string_value : values) {
-            const auto value = toDouble(string_value);
-            if (! value.has_value()) {
-                return std::unexpected(value.error());
+    // Stable to keep values of list options in the order of the file
+    std::ranges::stable_sort(config_values, {}, &std::pair<std::string_view, std::string_view>::first);
+
+    return {};
+}
+
+auto CLI::buildResults(
+    const ArgvParsingResult &parse_result, ParseContext &context, std::vector<Fault> *const faults
+) const -> std::expected<void, Fault> {
+    const auto &[raw_results, option_order, positional_arguments] = parse_result;
+    const auto &option_values                                     = context._results._values;
+    const auto profile                                            = context._profile;
+    std::vector<std::string_view> missing_required;
+
+    // When collecting faults, fault is kept and building goes on
+    const auto keep_going = [faults](Fault &&fault) -> bool {
+        if (faults == nullptr) {
+            return false;
+        }
+        faults->push_back(std::move(fault));
+        return true;
+    };
+
+    // Convert values given for option and store the result
+    const auto set_converted = [&](const std::shared_ptr<const Option> &option,
+                                   const std::span<const std::string_view> values,
+                                   const TokenSource source = TokenSource::Argv) -> std::expected<void, Fault> {
+        PhaseTimer timer(profile, ProfilePhase::Conversion);
+        auto value = getValueForOption(option, values);
+        if (! value.has_value()) {
+            auto fault   = std::move(value.error());
+            fault.option = option->name;
+            fault.source = source;
+            return std::unexpected(std::move(fault));
+        }
+        context.setValue(option->name, std::move(value.value()));
+        if (profile != nullptr) {
+            profile->options_matched++;
+            profile->values_converted += values.size();
+        }
+
+        return {};
+    };
+
+    // Scanned once, sorted by option name like `_options` so that the loop over options below walks them alongside
+    auto &environment_values = context._environment_values;
+    if (! _env_options.empty()) {
+        scanEnvironment([&](const std::string_view name, const std::string_view value) {
+            if (const auto option = _env_options.find(name); option != _env_options.end()) {
+                environment_values.emplace_back(option->second->name, value);
             }
-            double_results.push_back(value.value());
+        });
+        std::ranges::sort(environment_values);
+    }
+    auto environment_value = environment_values.begin();
+
+    if (const auto read = readConfigFile(context, keep_going); ! read.has_value()) {
+        return read;
+    }
+    const auto &config_values = context._config_values;
+    auto config_value         = config_values.begin();
+
+    if (_positional_options.empty() && ! positional_arguments.empty()) {
+        if (Fault fault = {.type = FaultType::UnrecognizedOption, .token = positional_arguments[0]};
+            ! keep_going(std::move(fault))) {
+            return std::unexpected(std::move(fault));
         }
-        return double_results;
     }
+    size_t positional_index = 0;
+    for (const auto &option_name : _positional_options) {
+        if (positional_index == positional_arguments.size()) {
+            break;
+        }
 
-    throw std::runtime_error(
-        "Type '" + std::string(option->type.name()) + "' is not allowed. It should have been caught before"
-    );
-}
+        const auto &option = _options.find(option_name)->second;
 
-auto CLI::help(std::ostream &out) const -> void {
-    out << std::format(
-        R"(usage:
-  {}
+        if (isNumberListType(option->type)) {
+            if (auto result = set_converted(option, std::span(positional_arguments).subspan(positional_index));
+                ! result.has_value() && ! keep_going(std::move(result.error()))) {
+                return result;
+            }
+            break;
+        }
 
-{}
+        if (auto result = set_converted(option, std::span(positional_arguments).subspan(positional_index, 1));
+            ! result.has_value() && ! keep_going(std::move(result.error()))) {
+            return result;
+        }
 
-)",
-        buildUsageHelp(),
-        _description
-    );
+        positional_index++;
+    }
 
-    if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
-        out << "Commands:\n"
-            << "\n";
+    for (const auto &option : _options | std::ranges::views::values) {
+        std::span<const std::string_view> values;
+        {
+            PhaseTimer timer(profile, ProfilePhase::Lookup);
+            // Options known by a previous run with the same context have no values
+            auto long_raw_values = raw_results.find(std::string_view(option->name));
+            if (long_raw_values != raw_results.end() && long_raw_values->second.empty()) {
+                long_raw_values = raw_results.end();
+            }
+            auto short_raw_values = raw_results.find(std::string_view(option->short_name));
+            if (short_raw_values != raw_results.end() && short_raw_values->second.empty()) {
+                short_raw_values = raw_results.end();
+            }
 
-        for (const auto &command : _commands | std::ranges::views::values) {
-            out << "  " << _commands_cli.at(command->getName()).buildUsageHelp() << "\n";
-            if (! command->getDescription().empty()) {
-                out << "    " << join(split(command->getDescription(), "\n"), "\n    ") << "\n";
+            if (long_raw_values != raw_results.end() && short_raw_values != raw_results.end()) {
+                auto long_values_it  = long_raw_values->second.begin();
+                auto short_values_it = short_raw_values->second.begin();
+                auto &merged_values  = context._values;
+                merged_values.clear();
+                // Assert that long_values.length + short_values.length === option_orders of (-n, --name).
+                // If it is not the case it means there is a bug in parseArgv and it should be fixed
+                for (const auto &oo : option_order) {
+                    if (oo == option->name) {
+                        merged_values.push_back(*long_values_it++);
+                    } else if (oo == option->short_name) {
+                        merged_values.push_back(*short_values_it++);
+                    }
+                }
+                values = merged_values;
+            } else if (long_raw_values != raw_results.end()) {
+                values = long_raw_values->second;
+            } else if (short_raw_values != raw_results.end()) {
+                values = short_raw_values->second;
             }
-            out << "\n";
         }
-    } else {
-        out << buildPositionalHelp();
 
-        for (const auto &[name, group] : _groups) {
-            if (group._options.empty()) {
-                continue;
+        while (environment_value != environment_values.end() && environment_value->first < option->name) {
+            ++environment_value;
+        }
+        const auto in_environment =
+            environment_value != environment_values.end() && environment_value->first == option->name;
+        while (config_value != config_values.end() && config_value->first < option->name) {
+            ++config_value;
+        }
+        auto config_end = config_value;
+        while (config_end != config_values.end() && config_end->first == option->name) {
+            ++config_end;
+        }
+
+        if (! values.empty()) {
+            if (auto result = set_converted(option, values);
+                ! result.has_value() && ! keep_going(std::move(result.error()))) {
+                return result;
             }
+        }
+
+        // Unless it was given as a positional argument
+        else if (in_environment && ! option_values.contains(std::string_view(option->name))) {
+            if (auto result = set_converted(option, std::span(&environment_value->second, 1), TokenSource::Environment);
+                ! result.has_value() && ! keep_going(std::move(result.error()))) {
+                return result;
+            }
+        }
+
+        else if (config_value != config_end && ! option_values.contains(std::string_view(option->name))) {
+            auto &file_values = context._values;
+            file_values.clear();
+            for (; config_value != config_end; ++config_value) {
+                file_values.push_back(config_value->second);
+            }
+            if (auto result = set_converted(option, file_values, TokenSource::ConfigFile);
+                ! result.has_value() && ! keep_going(std::move(result.error()))) {
+                return result;
+            }
+        }
 
-            out << (name.empty() ? "Options" : name) << ":\n"
-                << "\n";
+        else if (option->configuration.default_value.has_value()) {
+            PhaseTimer timer(profile, ProfilePhase::Defaults);
+            context.setValue(option->name, option->configuration.default_value.value());
+        }
 
-            for (const auto &option : group._options) {
-                out << "  " << buildOptionUsageHelp(option) << "\n"
-                    << "    " << join(split(option->description, "\n"), "\n    ") << "\n"
-                    << "\n";
+        else if (option->configuration.required) {
+            PhaseTimer timer(profile, ProfilePhase::RequiredChecks);
+            if (! option_values.contains(std::string_view(option->name))) {
+                missing_required.push_back(option->name);
             }
         }
     }
+
+    if (faults != nullptr) {
+        for (const auto &option : missing_required) {
+            faults->push_back({
+              .type            = FaultType::MissingRequiredOption,
+              .option          = option,
+              .missing_options = {option},
+            });
+        }
+    } else if (! missing_required.empty()) {
+        return std::unexpected<Fault>({
+          .type            = FaultType::MissingRequiredOption,
+          .option          = missing_required[0],
+          .missing_options = std::move(missing_required),
+        });
+    }
+
+    return {};
 }
 
-auto CLI::buildUsageHelp() const -> std::string {
-    auto usage = _name;
+template<typename T> auto toAny(std::expected<T, Fault> exp) -> std::expected<std::any, Fault> {
+    return exp.transform([](const auto &value) {
+        return std::any(value);
+    });
+}
 
-    if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
-        usage += " [COMMAND] [OPTIONS]";
-    } else {
-        if (! _options.empty()) {
-            usage += " [OPTIONS]";
-        }
-        for (const auto &option : _options | std::ranges::views::values) {
-            if (option->configuration.required && ! inArray(_positional_options, option->name)) {
-                usage += " --" + option->name;
+/**
+ * Convert all values of a list. From threshold values (if not 0), conversion is split in chunks converted by several
+ * threads, unless there are not 2 chunks to share or the thread is already one of a `parallelFor` (`CLI::runBatch`).
+ * In both cases, the Fault returned is the one of the first invalid value
+ */
+template<typename T>
+auto convertList(
+    const std::span<const std::string_view> values,
+    std::expected<T, Fault> (*convert)(std::string_view),
+    const size_t threshold
+) -> std::expected<std::any, Fault> {
+    std::vector<T> results(values.size());
+    if (threshold == 0 || values.size() < std::max(threshold, 2 * PARALLEL_CONVERSION_CHUNK_SIZE)
+        || inParallelFor()) {
+        for (size_t i = 0; i < values.size(); i++) {
+            const auto value = convert(values[i]);
+            if (! value.has_value()) {
+                return std::unexpected(value.error());
             }
+            results[i] = value.value();
         }
-        for (const auto &option : _positional_options) {
-            if (_options.at(option)->configuration.required) {
-                usage += " " + toUpper(option);
-            } else {
-                usage += " [" + toUpper(option) + "]";
+        return results;
+    }
+
+    // No thread without a whole chunk to convert
+    const auto thread_count = std::min(
+        static_cast<unsigned>(values.size() / PARALLEL_CONVERSION_CHUNK_SIZE),
+        std::max(1U, std::thread::hardware_concurrency())
+    );
+    // Index of the first invalid value found so far, chunks after it are useless
+    std::atomic first_error = values.size();
+    std::vector<std::optional<std::pair<size_t, Fault>>> errors(thread_count);
+    parallelFor(
+        values.size(),
+        thread_count,
+        PARALLEL_CONVERSION_CHUNK_SIZE,
+        [&](const unsigned thread_index, const size_t begin, const size_t end) {
+            for (auto i = begin; i < end && i < first_error.load(std::memory_order_relaxed); i++) {
+                auto value = convert(values[i]);
+                if (! value.has_value()) {
+                    auto &error = errors[thread_index];
+                    if (! error.has_value() || i < error->first) {
+                        error.emplace(i, std::move(value.error()));
+                    }
+                    auto current = first_error.load();
+                    while (i < current && ! first_error.compare_exchange_weak(current, i)) {}
+                    return;
+                }
+                results[i] = value.value();
             }
         }
+    );
+
+    const std::pair<size_t, Fault> *first = nullptr;
+    for (const auto &error : errors) {
+        if (error.has_value() && (first == nullptr || error->first < first->first)) {
+            first = &error.value();
+        }
+    }
+    if (first != nullptr) {
+        return std::unexpected(first->second);
     }
 
-    return usage;
+    return results;
 }
 
-auto CLI::buildPositionalHelp() const -> std::string {
-    if (_positional_options.empty()) {
-        return "";
+auto CLI::getValueForOption(const std::shared_ptr<const Option> &option, const std::span<const std::string_view> values)
+    const -> std::expected<std::any, Fault> {
+    const auto last_index = values.size() - 1;
+    if (option->type != OptionType::Boolean && values.size() == 1 && values[0] == "true") {
+        if (option->configuration.implicit_value.has_value()) {
+            return option->configuration.implicit_value.value();
+        } else {
+            return std::unexpected<Fault>({
+              .type   = FaultType::MissingOptionValue,
+              .option = option->name,
+            });
+        }
     }
 
-    std::string help
-        = "Positional arguments:\n"
-          "\n"
-          "  These arguments come after options and in the order they are listed here.\n";
-
-    if (_options.at(_positional_options[0])->configuration.required) {
-        help += "  Only ";
-        std::vector<std::string> required;
-        for (const auto &option : _positional_options) {
-            if (_options.at(option)->configuration.required) {
-                required.push_back(toUpper(option));
-            } else {
-                break;
+    switch (option->type) {
+        case OptionType::Boolean:
+            return toAny(toBoolean(values[last_index]));
+        case OptionType::String:
+            return std::string(values[last_index]);
+        case OptionType::Int:
+            return toAny(toInt(values[last_index]));
+        case OptionType::Float:
+            return toAny(toFloat(values[last_index]));
+        case OptionType::Double:
+            return toAny(toDouble(values[last_index]));
+        case OptionType::BooleanList: {
+            std::vector<bool> bool_results;
+            bool_results.reserve(values.size());
+            for (const auto &string_value : values) {
+                const auto value = toBoolean(string_value);
+                if (! value.has_value()) {
+                    return std::unexpected(value.error());
+                }
+                bool_results.push_back(value.value());
             }
+            return bool_results;
         }
-        help += join(required, ", ");
-        if (required.size() == 1) {
-            help += " is required.\n\n";
-        } else {
-            help += " are required.\n\n";
-        }
+        case OptionType::StringList:
+            return std::vector<std::string>(values.begin(), values.end());
+        case OptionType::IntList:
+            return convertList<int>(values, toInt, _parallel_conversion_threshold);
+        case OptionType::FloatList:
+            return convertList<float>(values, toFloat, _parallel_conversion_threshold);
+        case OptionType::DoubleList:
+            return convertList<double>(values, toDouble, _parallel_conversion_threshold);
     }
 
-    for (const auto &option_name : _positional_options) {
-        help += "  " + toUpper(option_name);
-        const auto option = _options.at(option_name);
-        if (option->configuration.required) {
-            help += " [REQUIRED]";
+    // Every OptionType is handled above, and addOption rejects any other type
+    std::unreachable();
+}
+
+auto CLI::help(std::ostream &out) const -> void {
+    // Only the help for the width set, or unwrapped when there is none, is cached: the one of a terminal can change
+    const auto width = _help_width.has_value() ? _help_width.value() : terminalWidth(out);
+    if (width != _help_width.value_or(0)) {
+        const auto help = buildHelp(width);
+        out.write(help.data(), static_cast<std::streamsize>(help.size()));
+        return;
+    }
+
+    const auto &help = _help.get([this, width] {
+        return buildHelp(width);
+    });
+    out.write(help.data(), static_cast<std::streamsize>(help.size()));
+}
+
+auto CLI::buildHelp(const size_t width) const -> std::string {
+    if (! _mode.has_value() || _mode.value() != Mode::COMMANDS) {
+        std::vector<StaticOption> options;
+        std::vector<std::string_view> positional;
+        return renderHelp(buildSchema(options, positional), width);
+    }
+
+    std::string help = "usage:\n  ";
+    help += buildUsageHelp();
+    help += "\n\n";
+    help += _description;
+    help += "\n\nCommands:\n\n";
+
+    for (const auto &command : _commands | std::ranges::views::values) {
+        const auto description = command->getDescription();
+        help += "  ";
+        help += _commands_cli.find(command->getName())->second.buildUsageHelp();
+        help += "\n";
+        if (! description.empty()) {
+            help += "    ";
+            appendIndentedLines(help, description, "    ", width);
+            help += "\n";
         }
-        help += "\n    ";
-        help += join(split(option->description, "\n"), "\n    ") + "\n\n";
+        help += "\n";
     }
 
     return help;
 }
 
-auto CLI::buildOptionUsageHelp(const std::shared_ptr<const Option> &option) -> std::string {
-    auto usage = "--" + option->name;
-    if (option->type != typeid(bool)) {
-        usage += " " + option->configuration.value_help;
+auto CLI::buildUsageHelp() const -> std::string {
+    if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+        return _name + " [COMMAND] [OPTIONS]";
     }
-    if (! option->short_name.empty()) {
-        usage += ", -" + option->short_name;
-        if (option->type != typeid(bool)) {
-            usage += " " + option->configuration.value_help;
+
+    std::vector<StaticOption> options;
+    std::vector<std::string_view> positional;
+    return renderUsageHelp(buildSchema(options, positional));
+}
+
+auto CLI::buildSchema(std::vector<StaticOption> &options, std::vector<std::string_view> &positional) const
+    -> StaticSchema {
+    options.reserve(_options.size());
+    for (const auto &group : _groups | std::ranges::views::values) {
+        for (const auto &option : group._options) {
+            options.push_back({
+              .name        = option->name,
+              .short_name  = option->short_name,
+              .description = option->description,
+              .type        = option->type,
+              .required    = option->configuration.required,
+              .value_help  = option->configuration.value_help,
+              .group       = group._name,
+              .env         = option->configuration.env,
+            });
         }
     }
-    if (option->configuration.required) {
-        usage += " [REQUIRED]";
-    }
+    positional.assign(_positional_options.begin(), _positional_options.end());
 
-    return usage;
+    return {
+      .name        = _name,
+      .description = _description,
+      .options     = options,
+      .positional  = positional,
+    };
 }
 
-auto CLI::checkOptionType(const std::type_info &type) -> void {
-    assert_message(
-        type == typeid(bool) || type == typeid(std::string) || type == typeid(int) || type == typeid(float)
-            || type == typeid(double) || type == typeid(std::vector<bool>) || type == typeid(std::vector<std::string>)
-            || type == typeid(std::vector<int>) || type == typeid(std::vector<float>)
-            || type == typeid(std::vector<double>),
-        "Type is not allowed for options"
+auto yeschief::printProfile(const RunProfile &profile, std::ostream &out) -> void {
+    static constexpr std::array<std::string_view, PROFILE_PHASE_COUNT> phase_names
+        = {"tokenize", "lookup", "conversion", "defaults", "required checks", "command dispatch"};
+    const auto microseconds = [](const std::chrono::nanoseconds duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    out << std::format(
+        "yeschief profile: {} tokens, {} options matched, {} values converted\n",
+        profile.tokens,
+        profile.options_matched,
+        profile.values_converted
     );
+    for (size_t i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        out << std::format("  {:<18}{:>12.3f} us\n", phase_names[i], microseconds(profile.durations[i]));
+    }
+    out << std::format("  {:<18}{:>12.3f} us\n", "total", microseconds(profile.total));
 }
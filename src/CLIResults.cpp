@@ -21,17 +21,75 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include "utils.h"
 #include "yeschief.h"
 
 using namespace yeschief;
 
-CLIResults::CLIResults(const std::map<std::string, std::any> &values): _values(values) {}
+/**
+ * First bytes of serialized results, to change with their format
+ */
+constexpr uint32_t SERIALIZED_RESULTS_MAGIC = 0x31524359;
+
+CLIResults::CLIResults(const std::map<std::string, std::any> &values, std::pmr::memory_resource *resource)
+    : _values(values.begin(), values.end(), resource) {}
 
 auto CLIResults::get(const std::string &option) const -> std::optional<std::any> {
-    const auto value = _values.find(option);
+    const auto value = _values.find(std::string_view(option));
     if (value == _values.end()) {
         return std::nullopt;
     }
 
     return value->second;
 }
+
+auto CLIResults::serialize(const uint64_t fingerprint) const -> std::expected<std::string, Fault> {
+    std::string out;
+    appendBinary(out, SERIALIZED_RESULTS_MAGIC);
+    appendBinary(out, fingerprint);
+    const auto count_offset = out.size();
+    uint32_t count          = 0;
+    appendBinary(out, count);
+
+    for (const auto &[name, value] : _values) {
+        const auto type = optionTypeOfValue(value);
+        if (! type.has_value()) {
+            return std::unexpected<Fault>({.type = FaultType::UnserializableValue, .option = name});
+        }
+        appendBinaryString(out, name);
+        appendBinaryValue(out, type.value(), value);
+        count++;
+    }
+    std::memcpy(out.data() + count_offset, &count, sizeof(count));
+
+    return out;
+}
+
+auto CLIResults::deserialize(
+    const std::string_view data, const uint64_t fingerprint, std::pmr::memory_resource *resource
+) -> std::expected<CLIResults, Fault> {
+    const auto invalid = std::unexpected<Fault>({.type = FaultType::InvalidSerializedResults});
+    BinaryReader reader(data);
+    if (reader.read<uint32_t>() != SERIALIZED_RESULTS_MAGIC || reader.read<uint64_t>() != fingerprint) {
+        return invalid;
+    }
+    const auto count = reader.read<uint32_t>();
+    if (! count.has_value()) {
+        return invalid;
+    }
+
+    CLIResults results({}, resource);
+    for (uint32_t i = 0; i < count.value(); i++) {
+        const auto name = reader.readString();
+        auto value      = reader.readValue();
+        if (! name.has_value() || ! value.has_value()) {
+            return invalid;
+        }
+        results._values.emplace(name.value(), std::move(value.value()));
+    }
+    if (! reader.empty()) {
+        return invalid;
+    }
+
+    return results;
+}
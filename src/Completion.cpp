@@ -0,0 +1,503 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <ranges>
+
+using namespace yeschief;
+
+namespace {
+auto firstLine(const std::string_view text) -> std::string_view {
+    return text.substr(0, text.find('\n'));
+}
+
+/**
+ * Escape text to be put in a single quoted string of a shell script. Characters of special are escaped by a backslash
+ */
+auto quoted(const std::string_view text, const std::string_view special = "") -> std::string {
+    std::string result;
+    for (const auto c : text) {
+        if (c == '\'') {
+            result += "'\\''";
+        } else {
+            if (special.contains(c)) {
+                result += '\\';
+            }
+            result += c;
+        }
+    }
+
+    return result;
+}
+
+/**
+ * Name of the shell function completing program, program name may contain characters not allowed in it
+ */
+auto functionName(const std::string_view program) -> std::string {
+    std::string name = "_yeschief_";
+    for (const auto c : program) {
+        name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+    }
+
+    return name;
+}
+
+/**
+ * @return Whether values of an option of type are completed with file names
+ */
+auto takesFiles(const OptionType type) -> bool {
+    return type == OptionType::String || type == OptionType::StringList;
+}
+
+auto isList(const OptionType type) -> bool {
+    return type == OptionType::BooleanList || type == OptionType::StringList || isNumberListType(type);
+}
+
+/**
+ * Bash completing with candidates printed by the program, given the words up to the current one
+ */
+constexpr std::string_view BASH_VALUES =
+    R"(mapfile -t COMPREPLY < <("$1" __complete "${COMP_WORDS[@]:1:COMP_CWORD}" 2>/dev/null))";
+
+/**
+ * Fish arguments completing with candidates printed by program, given the words up to the current one
+ */
+auto fishValues(const std::string_view program) -> std::string {
+    return " -a '(" + quoted(program, "\\") + " __complete (commandline -opc)[2..-1] (commandline -ct))'";
+}
+
+/**
+ * Zsh action completing with candidates printed by program, given the words from first_word to the current one
+ *
+ * @param path Words preceding first_word which zsh no longer has, as the names of parent commands each followed by a
+ * space
+ */
+auto zshValuesAction(const std::string_view program, const std::string_view path, const int first_word)
+    -> std::string {
+    return "{local -a values=(${(f)\"$(" + quoted(program) + " __complete " + quoted(path) + "\"${(@)words["
+         + std::to_string(first_word) + ",CURRENT]}\" 2>/dev/null)\"}); compadd -a values}";
+}
+
+/**
+ * @param values Action calling the program
+ * @return Zsh action completing values of option
+ */
+auto zshAction(const Option &option, const std::string_view values) -> std::string {
+    if (option.configuration.completion != nullptr) {
+        return std::string(values);
+    }
+
+    return takesFiles(option.type) ? "_files" : " ";
+}
+} // namespace
+
+auto CLI::complete(const std::span<const std::string> words) const -> std::vector<std::string> {
+    std::vector<std::string> candidates;
+    if (words.empty()) {
+        return candidates;
+    }
+    const std::string_view current = words.back();
+
+    if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+        if (words.size() > 1) {
+            const auto command_name = resolveCommand(words.front());
+            if (! command_name.has_value()) {
+                return candidates;
+            }
+            return _commands_cli.find(command_name.value())->second.complete(words.subspan(1));
+        }
+        for (auto command = _commands.lower_bound(current);
+             command != _commands.end() && command->first.starts_with(current);
+             ++command) {
+            candidates.push_back(command->first);
+        }
+        return candidates;
+    }
+
+    const auto append_values = [&candidates](const Option &option, const std::string_view value, const auto &prefix) {
+        if (option.configuration.completion == nullptr) {
+            return;
+        }
+        for (auto &candidate : option.configuration.completion(value)) {
+            if (candidate.starts_with(value)) {
+                candidates.push_back(prefix + candidate);
+            }
+        }
+    };
+
+    IncrementalParser parser(*this);
+    for (const auto &word : words.first(words.size() - 1)) {
+        if (! parser.push(word).has_value()) {
+            return candidates;
+        }
+    }
+    const auto [type, option] = parser.expects();
+    const auto takes_options  = type == ExpectationType::OptionOrPositional
+                            || (type == ExpectationType::OptionValue && option->type == OptionType::Boolean);
+
+    if (takes_options && current.starts_with('-')) {
+        // --name=value, name being resolved like run does
+        if (const auto equal = current.find('='); current.starts_with("--") && equal != std::string_view::npos) {
+            if (const auto named = resolveOption(current.substr(2, equal - 2)); named != nullptr) {
+                append_values(*named, current.substr(equal + 1), std::string(current.substr(0, equal + 1)));
+            }
+            return candidates;
+        }
+        if (! current.starts_with("--") && current != "-") {
+            if (current.size() == 2 && _short_options.contains(current.substr(1))) {
+                candidates.emplace_back(current);
+            }
+            return candidates;
+        }
+
+        const auto prefix = current.substr(std::min<size_t>(current.size(), 2));
+        for (auto named = _options.lower_bound(prefix); named != _options.end() && named->first.starts_with(prefix);
+             ++named) {
+            candidates.push_back("--" + named->first);
+        }
+        if (current == "-") {
+            for (const auto &short_name : _short_options | std::views::keys) {
+                candidates.push_back("-" + short_name);
+            }
+        }
+        return candidates;
+    }
+
+    if (type != ExpectationType::Nothing && option != nullptr) {
+        append_values(*option, current, std::string());
+    }
+
+    return candidates;
+}
+
+auto CLI::printCompletion(const std::span<char *const> words) const -> void {
+    const std::vector<std::string> arguments(words.begin(), words.end());
+    std::string output;
+    for (const auto &candidate : complete(arguments)) {
+        output += candidate;
+        output += '\n';
+    }
+    std::cout.write(output.data(), static_cast<std::streamsize>(output.size()));
+    std::cout.flush();
+}
+
+auto CLI::completionScript(const Shell shell) const -> std::string {
+    std::string script;
+
+    switch (shell) {
+        case Shell::Bash: {
+            const auto function = functionName(_name);
+            script += "# bash completion for " + _name + ", generated by yeschief\n";
+            script += function + "() {\n";
+            script += "    local cur=\"${COMP_WORDS[COMP_CWORD]}\"\n";
+            script += "    local prev=\"${COMP_WORDS[COMP_CWORD-1]}\"\n";
+            if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+                script += "    local command word i=1\n";
+                appendBashCommands(script, "    ");
+            } else {
+                appendBashCompletion(script, "    ");
+            }
+            script += "}\n"
+                      "complete -F " + function + " " + _name + "\n";
+            break;
+        }
+        case Shell::Zsh: {
+            // Autoloaded zsh completions are functions named after their file, _<program name> by convention
+            const auto function = "_" + _name;
+            script += "#compdef " + _name + "\n"
+                      "# zsh completion for " + _name + ", generated by yeschief\n"
+                      "\n"
+                      + function + "() {\n";
+            if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+                script += "    local line state\n";
+                appendZshCommands(script, "    ", _name, "");
+            } else {
+                appendZshCompletion(script, "    ", zshValuesAction(_name, "", 2));
+            }
+            script += "}\n"
+                      "\n"
+                      "if [ \"$funcstack[1]\" = \"" + function + "\" ]; then\n"
+                      "    " + function + " \"$@\"\n"
+                      "else\n"
+                      "    compdef " + function + " " + _name + "\n"
+                      "fi\n";
+            break;
+        }
+        case Shell::Fish:
+            script += "# fish completion for " + _name + ", generated by yeschief\n";
+            if (_mode.has_value() && _mode.value() == Mode::COMMANDS) {
+                script += "complete -c " + _name + " -f\n";
+                appendFishCommands(script, _name, "");
+            } else {
+                appendFishCompletion(script, _name, "");
+            }
+            break;
+    }
+
+    return script;
+}
+
+auto CLI::completionOptions() const -> std::vector<std::shared_ptr<const Option>> {
+    std::vector<std::shared_ptr<const Option>> options;
+    options.reserve(_options.size());
+    for (const auto &group : _groups | std::views::values) {
+        options.insert(options.end(), group._options.begin(), group._options.end());
+    }
+
+    return options;
+}
+
+auto CLI::completesPositionalFiles() const -> bool {
+    return ! completesPositionalValues() && std::ranges::any_of(_positional_options, [this](const std::string &name) {
+        return takesFiles(_options.find(name)->second->type);
+    });
+}
+
+auto CLI::completesPositionalValues() const -> bool {
+    return std::ranges::any_of(_positional_options, [this](const std::string &name) {
+        return _options.find(name)->second->configuration.completion != nullptr;
+    });
+}
+
+auto CLI::appendBashCompletion(std::string &script, const std::string_view indent) const -> void {
+    const auto line = [&](const std::string_view text) {
+        script += indent;
+        script += text;
+        script += '\n';
+    };
+    const auto options = completionOptions();
+
+    if (std::ranges::any_of(options, [](const auto &option) { return option->type != OptionType::Boolean; })) {
+        line("case \"$prev\" in");
+        for (const auto &option : options) {
+            if (option->type == OptionType::Boolean) {
+                continue;
+            }
+            line(
+                "    --" + option->name + (option->short_name.empty() ? "" : "|-" + option->short_name) + ")"
+            );
+            if (option->configuration.completion != nullptr) {
+                line("        " + std::string(BASH_VALUES));
+            } else if (takesFiles(option->type)) {
+                line("        COMPREPLY=($(compgen -f -- \"$cur\"))");
+            } else {
+                line("        COMPREPLY=()");
+            }
+            line("        return");
+            line("        ;;");
+        }
+        line("esac");
+    }
+
+    std::string words;
+    for (const auto &option : options) {
+        words += (words.empty() ? "--" : " --") + option->name;
+        if (! option->short_name.empty()) {
+            words += " -" + option->short_name;
+        }
+    }
+    line("if [[ \"$cur\" == -* ]]; then");
+    line("    COMPREPLY=($(compgen -W \"" + words + "\" -- \"$cur\"))");
+    line("    return");
+    line("fi");
+    if (completesPositionalValues()) {
+        line(BASH_VALUES);
+    } else if (completesPositionalFiles()) {
+        line("COMPREPLY=($(compgen -f -- \"$cur\"))");
+    }
+}
+
+auto CLI::appendBashCommands(std::string &script, const std::string_view indent) const -> void {
+    const auto line = [&](const std::string_view text) {
+        script += indent;
+        script += text;
+        script += '\n';
+    };
+    const auto commands = _commands | std::views::keys;
+    const auto nested   = std::string(indent) + "        ";
+
+    // Find the command among the words following the ones of parent commands
+    line("command=\"\"");
+    line("while [[ $i -lt $COMP_CWORD ]]; do");
+    line("    word=\"${COMP_WORDS[i]}\"");
+    line("    i=$((i + 1))");
+    line("    case \"$word\" in");
+    line("        " + join(commands, "|") + ")");
+    line("            command=\"$word\"");
+    line("            break");
+    line("            ;;");
+    line("    esac");
+    line("done");
+    script += '\n';
+    line("case \"$command\" in");
+    line("    \"\")");
+    line("        COMPREPLY=($(compgen -W \"" + join(commands, " ") + "\" -- \"$cur\"))");
+    line("        ;;");
+    for (const auto &[name, command_cli] : _commands_cli) {
+        line("    " + name + ")");
+        if (command_cli._mode.has_value() && command_cli._mode.value() == Mode::COMMANDS) {
+            command_cli.appendBashCommands(script, nested);
+        } else {
+            command_cli.appendBashCompletion(script, nested);
+        }
+        line("        ;;");
+    }
+    line("esac");
+}
+
+auto CLI::appendZshCompletion(std::string &script, const std::string_view indent, const std::string_view values) const
+    -> void {
+    constexpr std::string_view special = "[]:\\";
+    std::vector<std::string> specs;
+
+    for (const auto &option : completionOptions()) {
+        const auto description = "[" + quoted(firstLine(option->description), special) + "]";
+        std::string value;
+        if (option->type != OptionType::Boolean) {
+            value = ":" + quoted(option->configuration.value_help, special) + ":" + zshAction(*option, values);
+        }
+        const auto repeat = isList(option->type) ? "*" : "";
+
+        if (option->short_name.empty()) {
+            specs.push_back(std::string("'") + repeat + "--" + option->name + description + value + "'");
+        } else {
+            const auto names = "--" + option->name + " -" + option->short_name;
+            specs.push_back(
+                (isList(option->type) ? "'*'" : "'(" + names + ")'") + "{--" + option->name + ",-"
+                + option->short_name + "}'" + description + value + "'"
+            );
+        }
+    }
+    for (const auto &name : _positional_options) {
+        const auto &option = _options.find(name)->second;
+        std::string spec   = isList(option->type) ? "'*:" : option->configuration.required ? "':" : "'::";
+        std::string upper_name;
+        appendUpper(upper_name, name);
+        spec += quoted(upper_name, special) + ":" + zshAction(*option, values) + "'";
+        specs.push_back(spec);
+    }
+
+    script += indent;
+    script += "_arguments -s";
+    for (const auto &spec : specs) {
+        script += " \\\n";
+        script += indent;
+        script += "    ";
+        script += spec;
+    }
+    script += '\n';
+}
+
+auto CLI::appendZshCommands(
+    std::string &script, const std::string_view indent, const std::string_view program, const std::string &path
+) const -> void {
+    const auto line = [&](const std::string_view text) {
+        script += indent;
+        script += text;
+        script += '\n';
+    };
+
+    // Each `*::` state drops the words before the command, so the nested _arguments start again at its name
+    line("_arguments -C '1: :->command' '*:: :->argument'");
+    line("case $state in");
+    line("    command)");
+    line("        local -a commands=(");
+    for (const auto &[name, command] : _commands) {
+        const auto description = command->getDescription();
+        line("            '" + quoted(name, ":") + ":" + quoted(firstLine(description)) + "'");
+    }
+    line("        )");
+    line("        _describe 'command' commands");
+    line("        ;;");
+    line("    argument)");
+    line("        case $line[1] in");
+    const auto nested = std::string(indent) + "                ";
+    for (const auto &[name, command_cli] : _commands_cli) {
+        line("            " + name + ")");
+        if (command_cli._mode.has_value() && command_cli._mode.value() == Mode::COMMANDS) {
+            command_cli.appendZshCommands(script, nested, program, path + name + " ");
+        } else {
+            // Words of the command start at its name
+            command_cli.appendZshCompletion(script, nested, zshValuesAction(program, path, 1));
+        }
+        line("                ;;");
+    }
+    line("        esac");
+    line("        ;;");
+    line("esac");
+}
+
+auto CLI::appendFishCommands(std::string &script, const std::string_view program, const std::string &condition) const
+    -> void {
+    // Commands are listed until one of them is given
+    const auto listed = condition.empty() ? std::string("__fish_use_subcommand")
+                                          : condition + "; and not __fish_seen_subcommand_from "
+                                                + join(_commands | std::views::keys, " ");
+    for (const auto &[name, command] : _commands) {
+        const auto description = command->getDescription();
+        script += "complete -c " + std::string(program) + " -n '" + listed + "' -a '" + quoted(name, "\\") + "' -d '"
+                + quoted(firstLine(description), "\\") + "'\n";
+    }
+    for (const auto &[name, command_cli] : _commands_cli) {
+        const auto seen = (condition.empty() ? "" : condition + "; and ") + "__fish_seen_subcommand_from " + name;
+        if (command_cli._mode.has_value() && command_cli._mode.value() == Mode::COMMANDS) {
+            command_cli.appendFishCommands(script, program, seen);
+        } else {
+            command_cli.appendFishCompletion(script, program, seen);
+        }
+    }
+}
+
+auto CLI::appendFishCompletion(std::string &script, const std::string_view program, const std::string &condition) const
+    -> void {
+    std::string prefix = "complete -c " + std::string(program);
+    if (! condition.empty()) {
+        prefix += " -n '" + condition + "'";
+    }
+
+    if (condition.empty() && ! completesPositionalFiles()) {
+        script += prefix + " -f\n";
+    }
+    for (const auto &option : completionOptions()) {
+        script += prefix + " -l " + option->name;
+        if (! option->short_name.empty()) {
+            script += " -s " + option->short_name;
+        }
+        if (option->configuration.completion != nullptr) {
+            script += " -x" + fishValues(program);
+        } else if (option->type != OptionType::Boolean) {
+            script += takesFiles(option->type) ? " -r -F" : " -x";
+        }
+        script += " -d '" + quoted(firstLine(option->description), "\\") + "'\n";
+    }
+    if (completesPositionalValues()) {
+        script += prefix + fishValues(program) + "\n";
+    } else if (! condition.empty() && completesPositionalFiles()) {
+        script += prefix + " -F\n";
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+#include <utility>
+
+using namespace yeschief;
+
+auto ConfigFile::open(const std::string &path) -> std::expected<ConfigFile, std::error_code> {
+    const auto content = mapFile(path);
+    if (! content.has_value()) {
+        return std::unexpected(content.error());
+    }
+
+    return ConfigFile(content.value());
+}
+
+ConfigFile::ConfigFile(const std::string_view content): _content(content) {}
+
+ConfigFile::ConfigFile(ConfigFile &&other) noexcept: _content(std::exchange(other._content, {})) {}
+
+auto ConfigFile::operator=(ConfigFile &&other) noexcept -> ConfigFile & {
+    std::swap(_content, other._content);
+    return *this;
+}
+
+ConfigFile::~ConfigFile() {
+    unmapFile(_content);
+}
+
+auto ConfigFile::content() const -> std::string_view {
+    return _content;
+}
@@ -0,0 +1,141 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+using namespace yeschief;
+
+namespace {
+/**
+ * @return End of the message suggesting candidates, each one written after prefix. Empty if there is none
+ */
+auto didYouMean(const std::vector<std::string_view> &candidates, const std::string_view prefix) -> std::string {
+    if (candidates.empty()) {
+        return "";
+    }
+
+    std::string suggestion = ", did you mean ";
+    for (size_t i = 0; i < candidates.size(); i++) {
+        if (i > 0) {
+            suggestion += i + 1 == candidates.size() ? " or " : ", ";
+        }
+        suggestion += prefix;
+        suggestion += candidates[i];
+    }
+
+    return suggestion + "?";
+}
+
+/**
+ * @return names separated by a comma, each one written after prefix
+ */
+auto listNames(const std::vector<std::string_view> &names, const std::string_view prefix) -> std::string {
+    std::string list;
+    for (const auto name : names) {
+        if (! list.empty()) {
+            list += ", ";
+        }
+        list += prefix;
+        list += name;
+    }
+
+    return list;
+}
+} // namespace
+
+auto Fault::suggestions() const -> std::vector<std::string_view> {
+    if (cli == nullptr) {
+        return {};
+    }
+
+    switch (type) {
+        case FaultType::UnrecognizedOption:
+            return suggest(token, cli->_options | std::views::keys);
+        case FaultType::UnknownCommand:
+            return suggest(token, cli->_commands | std::views::keys);
+        default:
+            return {};
+    }
+}
+
+auto Fault::message() const -> std::string {
+    switch (type) {
+        case FaultType::InvalidArgs:
+            return "argc cannot be less than 1, argv should at least contains executable name";
+        case FaultType::UnrecognizedOption: {
+            // Keys of the config file are option names as is
+            const auto prefix = source == TokenSource::ConfigFile ? "" : "--";
+            return "Unrecognized option: " + std::string(token) + didYouMean(suggestions(), prefix);
+        }
+        case FaultType::MissingRequiredOption:
+            return "Some required options were not given: " + join(missing_options, ", ");
+        case FaultType::InvalidOptionType: {
+            const auto article = expected_type.starts_with('i') ? "an " : "a ";
+            return "'" + std::string(token) + "' cannot be parsed to " + article + std::string(expected_type)
+                 + " value";
+        }
+        case FaultType::MissingOptionValue:
+            return "Option '" + std::string(option) + "' needs a value";
+        case FaultType::UnknownCommand:
+            return "Command '" + std::string(token) + "' not found" + didYouMean(suggestions(), "");
+        case FaultType::AmbiguousPrefix: {
+            // Candidates are options, unless they are commands of cli
+            const auto prefix = cli != nullptr && cli->_mode == CLI::Mode::COMMANDS ? "" : "--";
+            return "'" + std::string(token) + "' is ambiguous, it may be: " + listNames(candidates, prefix);
+        }
+        case FaultType::InvalidConfigFile:
+            return "Invalid line in config file: " + std::string(token);
+        case FaultType::InvalidSerializedResults:
+            return "Serialized results are truncated or come from another CLI";
+        case FaultType::UnserializableValue:
+            return "Value of option '" + std::string(option)
+                 + "' has not the type of an option, it cannot be serialized";
+        case FaultType::InvalidSchema:
+            return "Schema describes options or commands that cannot be added to its CLI";
+    }
+
+    return "";
+}
+
+namespace {
+class FaultCategory final : public std::error_category {
+  public:
+    [[nodiscard]] auto name() const noexcept -> const char * override {
+        return "yeschief";
+    }
+
+    [[nodiscard]] auto message(const int value) const -> std::string override {
+        return Fault{.type = static_cast<FaultType>(value)}.message();
+    }
+};
+} // namespace
+
+auto yeschief::faultCategory() -> const std::error_category & {
+    static const FaultCategory category;
+    return category;
+}
+
+auto yeschief::make_error_code(const FaultType type) -> std::error_code {
+    return {static_cast<int>(type), faultCategory()};
+}
@@ -0,0 +1,180 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+using namespace yeschief;
+
+IncrementalParser::IncrementalParser(const CLI &cli)
+    : _cli(&cli), _state(std::make_unique<ArgvParsingState>(std::pmr::get_default_resource(), true)) {}
+
+IncrementalParser::IncrementalParser(const IncrementalParser &other)
+    : _cli(other._cli),
+      _state(std::make_unique<ArgvParsingState>(std::pmr::get_default_resource(), true)),
+      _command_parser(
+          other._command_parser != nullptr ? std::make_unique<IncrementalParser>(*other._command_parser) : nullptr
+      ) {
+    replay(*other._state);
+}
+
+auto IncrementalParser::operator=(const IncrementalParser &other) -> IncrementalParser & {
+    if (this != &other) {
+        _cli   = other._cli;
+        _state = std::make_unique<ArgvParsingState>(std::pmr::get_default_resource(), true);
+        replay(*other._state);
+        _command_parser
+            = other._command_parser != nullptr ? std::make_unique<IncrementalParser>(*other._command_parser) : nullptr;
+    }
+
+    return *this;
+}
+
+IncrementalParser::~IncrementalParser() = default;
+
+auto IncrementalParser::push(const std::string &argument) -> std::expected<void, Fault> {
+    if (_cli->_mode.has_value() && _cli->_mode.value() == CLI::Mode::COMMANDS) {
+        if (_command_parser != nullptr) {
+            if (auto result = _command_parser->push(argument); ! result.has_value()) {
+                auto fault = std::move(result.error());
+                if (fault.argument_index.has_value()) {
+                    fault.argument_index.value()++;
+                }
+                return std::unexpected(std::move(fault));
+            }
+            return {};
+        }
+
+        const auto command_name = _cli->resolveCommand(argument);
+        if (! command_name.has_value()) {
+            // Kept so that the fault token stays valid
+            _state->kept_arguments.emplace_back(argument);
+            auto fault           = command_name.error();
+            fault.token          = _state->kept_arguments.back();
+            fault.argument_index = 1;
+            return std::unexpected(std::move(fault));
+        }
+        _command_parser = std::make_unique<IncrementalParser>(_cli->_commands_cli.find(command_name.value())->second);
+        return {};
+    }
+
+    const std::function is_option = [this](const std::string_view name) {
+        return _cli->hasOption(name);
+    };
+    const std::function prefixes = [this] {
+        return _cli->optionPrefixes();
+    };
+    if (auto result = parseArgument(argument, is_option, *_state, prefixes); ! result.has_value()) {
+        auto fault = std::move(result.error());
+        locateArgument(fault, _state->kept_arguments, 1);
+        fault.cli = _cli;
+        return std::unexpected(std::move(fault));
+    }
+
+    return {};
+}
+
+auto IncrementalParser::expects() const -> Expectation {
+    if (_cli->_mode.has_value() && _cli->_mode.value() == CLI::Mode::COMMANDS) {
+        if (_command_parser != nullptr) {
+            return _command_parser->expects();
+        }
+        return {.type = ExpectationType::Command};
+    }
+
+    if (_state->current_option.has_value()) {
+        return {
+          .type   = ExpectationType::OptionValue,
+          .option = _cli->findOption(_state->current_option.value()),
+        };
+    }
+
+    std::shared_ptr<const Option> next_positional = nullptr;
+    const auto &positional_options                = _cli->_positional_options;
+    const auto positional_index                   = _state->result.positional_arguments.size();
+    if (positional_index < positional_options.size()) {
+        next_positional = _cli->_options.find(positional_options[positional_index])->second;
+    } else if (! positional_options.empty()) {
+        const auto last_option = _cli->_options.find(positional_options[positional_options.size() - 1])->second;
+        if (isNumberListType(last_option->type)) {
+            next_positional = last_option;
+        }
+    }
+
+    if (_state->in_positional || ! _state->result.positional_arguments.empty()) {
+        if (next_positional == nullptr) {
+            return {.type = ExpectationType::Nothing};
+        }
+        return {.type = ExpectationType::Positional, .option = next_positional};
+    }
+
+    return {.type = ExpectationType::OptionOrPositional, .option = next_positional};
+}
+
+auto IncrementalParser::finish() const -> std::expected<CLIResults, Fault> {
+    if (_cli->_mode.has_value() && _cli->_mode.value() == CLI::Mode::COMMANDS) {
+        if (_command_parser != nullptr) {
+            auto results = _command_parser->finish();
+            if (! results.has_value() && results.error().argument_index.has_value()) {
+                results.error().argument_index.value()++;
+            }
+            return results;
+        }
+        return CLIResults({});
+    }
+
+    // Views of the result stay on arguments kept by this parser
+    ParseContext context;
+    context._state->result         = _state->result;
+    context._state->current_option = _state->current_option;
+    endParsing(*context._state);
+    if (auto result = _cli->buildResults(context._state->result, context); ! result.has_value()) {
+        auto fault = std::move(result.error());
+        locateArgument(fault, _state->kept_arguments, 1);
+        fault.cli = _cli;
+        return std::unexpected(std::move(fault));
+    }
+
+    return std::move(context._results);
+}
+
+auto IncrementalParser::reset() -> void {
+    resetParsing(*_state);
+    _command_parser = nullptr;
+}
+
+auto IncrementalParser::replay(const ArgvParsingState &state) -> void {
+    if (_cli->_mode.has_value() && _cli->_mode.value() == CLI::Mode::COMMANDS) {
+        return;
+    }
+    const std::function is_option = [this](const std::string_view name) {
+        return _cli->hasOption(name);
+    };
+    const std::function prefixes = [this] {
+        return _cli->optionPrefixes();
+    };
+    // Parsing is deterministic: pushing the same arguments gives the same state, with views on its own copies
+    for (const auto &argument : state.kept_arguments) {
+        (void) parseArgument(argument, is_option, *_state, prefixes);
+    }
+}
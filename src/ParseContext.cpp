@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+#include <utility>
+
+using namespace yeschief;
+
+ParseContext::ParseContext(std::pmr::memory_resource *resource)
+    : _state(std::make_unique<ArgvParsingState>(resource)),
+      _values(resource),
+      _environment_values(resource),
+      _config_values(resource),
+      _config_entries(resource),
+      _results({}, resource),
+      _free_nodes(resource) {}
+
+ParseContext::~ParseContext() = default;
+
+auto ParseContext::clear() -> void {
+    resetParsing(*_state);
+    _values.clear();
+    _environment_values.clear();
+    _config_values.clear();
+    _config_entries.clear();
+    _config_read = false;
+    _config_fault.reset();
+    auto &values = _results._values;
+    while (! values.empty()) {
+        _free_nodes.insert(values.extract(values.begin()));
+    }
+}
+
+auto ParseContext::setValue(const std::string_view option, std::any value) -> void {
+    auto &values = _results._values;
+    if (values.contains(option)) {
+        return;
+    }
+
+    if (_free_nodes.empty()) {
+        values.emplace(option, std::move(value));
+        return;
+    }
+
+    // Prefer a node with the same key, it is the common case when parsing again with the same CLI
+    const auto same_key = _free_nodes.find(option);
+    auto node           = _free_nodes.extract(same_key != _free_nodes.end() ? same_key : _free_nodes.begin());
+    node.key()          = option;
+    node.mapped()       = std::move(value);
+    values.insert(std::move(node));
+}
@@ -0,0 +1,528 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "utils.h"
+#include "yeschief.h"
+
+#include <charconv>
+#include <cmath>
+#include <ranges>
+
+using namespace yeschief;
+
+/**
+ * First bytes of a binary schema, to change with its format
+ */
+constexpr uint32_t SCHEMA_MAGIC = 0x31534359;
+
+namespace {
+/**
+ * Modes of a CLI in a binary schema, no mode being 0
+ */
+constexpr uint8_t SCHEMA_MODE_OPTIONS  = 1;
+constexpr uint8_t SCHEMA_MODE_COMMANDS = 2;
+
+/**
+ * @return Whether value is exported for an option of type: only values of this type are
+ */
+auto isExportedValue(const std::optional<std::any> &value, const OptionType type) -> bool {
+    return value.has_value() && optionTypeOfValue(value.value()) == type;
+}
+
+/**
+ * Append whether value is exported then, if it is, the value itself
+ */
+auto appendSchemaValue(std::string &out, const std::optional<std::any> &value, const OptionType type) -> void {
+    const auto exported = isExportedValue(value, type);
+    appendBinary(out, static_cast<uint8_t>(exported));
+    if (exported) {
+        appendBinaryValue(out, type, value.value());
+    }
+}
+
+auto malformedSchema() -> std::unexpected<std::error_code> {
+    return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+}
+
+/**
+ * @return Whether reader has a value, then the value. `std::errc::illegal_byte_sequence` if data is invalid, an
+ * `InvalidSchema` error if the value is not of type
+ */
+auto readSchemaValue(BinaryReader &reader, const OptionType type)
+    -> std::expected<std::optional<std::any>, std::error_code> {
+    const auto exported = reader.readBool();
+    if (! exported.has_value()) {
+        return malformedSchema();
+    }
+    if (! exported.value()) {
+        return std::optional<std::any>();
+    }
+    auto value = reader.readValue();
+    if (! value.has_value()) {
+        return malformedSchema();
+    }
+    if (optionTypeOfValue(value.value()) != type) {
+        return std::unexpected(make_error_code(FaultType::InvalidSchema));
+    }
+
+    return std::optional<std::any>(std::move(value.value()));
+}
+
+/**
+ * @return The option, or the error of `readSchemaValue`
+ */
+auto readSchemaOption(BinaryReader &reader) -> std::expected<Option, std::error_code> {
+    const auto name        = reader.readString();
+    const auto short_name  = reader.readString();
+    const auto description = reader.readString();
+    const auto type        = reader.read<uint8_t>();
+    const auto required    = reader.readBool();
+    const auto value_help  = reader.readString();
+    const auto env         = reader.readString();
+    if (! name.has_value() || ! short_name.has_value() || ! description.has_value() || ! type.has_value()
+        || type.value() > static_cast<uint8_t>(OptionType::DoubleList) || ! required.has_value()
+        || ! value_help.has_value() || ! env.has_value()) {
+        return malformedSchema();
+    }
+    const auto option_type = static_cast<OptionType>(type.value());
+    auto default_value     = readSchemaValue(reader, option_type);
+    if (! default_value.has_value()) {
+        return std::unexpected(default_value.error());
+    }
+    auto implicit_value = readSchemaValue(reader, option_type);
+    if (! implicit_value.has_value()) {
+        return std::unexpected(implicit_value.error());
+    }
+
+    return Option{
+      .name          = std::string(name.value()),
+      .short_name    = std::string(short_name.value()),
+      .description   = std::string(description.value()),
+      .type          = option_type,
+      .configuration = {
+        .required       = required.value(),
+        .value_help     = std::string(value_help.value()),
+        .default_value  = std::move(default_value.value()),
+        .implicit_value = std::move(implicit_value.value()),
+        .env            = std::string(env.value()),
+      },
+    };
+}
+
+auto appendJsonString(std::string &out, const std::string_view str) -> void {
+    out += '"';
+    for (const auto c : str) {
+        switch (c) {
+            case '"':
+                out += "\\\"";
+                break;
+            case '\\':
+                out += "\\\\";
+                break;
+            case '\n':
+                out += "\\n";
+                break;
+            case '\r':
+                out += "\\r";
+                break;
+            case '\t':
+                out += "\\t";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    constexpr std::string_view digits = "0123456789abcdef";
+                    out += "\\u00";
+                    out += digits[static_cast<unsigned char>(c) >> 4];
+                    out += digits[static_cast<unsigned char>(c) & 0xf];
+                } else {
+                    out += c;
+                }
+        }
+    }
+    out += '"';
+}
+
+template<typename T> auto appendJsonNumber(std::string &out, const T number) -> void {
+    if constexpr (std::is_floating_point_v<T>) {
+        // JSON has no infinity nor NaN
+        if (! std::isfinite(number)) {
+            out += "null";
+            return;
+        }
+    }
+    std::array<char, 32> buffer{};
+    const auto result = std::to_chars(buffer.data(), buffer.data() + buffer.size(), number);
+    out.append(buffer.data(), result.ptr);
+}
+
+template<typename T, typename Append>
+auto appendJsonArray(std::string &out, const std::vector<T> &values, Append &&append) -> void {
+    out += '[';
+    for (size_t i = 0; i < values.size(); i++) {
+        if (i > 0) {
+            out += ", ";
+        }
+        append(out, values[i]);
+    }
+    out += ']';
+}
+
+auto appendJsonValue(std::string &out, const std::any &value) -> void {
+    const auto append_bool = [](std::string &json, const bool boolean) {
+        json += boolean ? "true" : "false";
+    };
+    const auto append_string = [](std::string &json, const std::string &str) {
+        appendJsonString(json, str);
+    };
+    const auto append_number = [](std::string &json, const auto number) {
+        appendJsonNumber(json, number);
+    };
+
+    switch (optionTypeOfValue(value).value()) {
+        case OptionType::Boolean:
+            append_bool(out, *std::any_cast<bool>(&value));
+            break;
+        case OptionType::String:
+            append_string(out, *std::any_cast<std::string>(&value));
+            break;
+        case OptionType::Int:
+            append_number(out, *std::any_cast<int>(&value));
+            break;
+        case OptionType::Float:
+            append_number(out, *std::any_cast<float>(&value));
+            break;
+        case OptionType::Double:
+            append_number(out, *std::any_cast<double>(&value));
+            break;
+        case OptionType::BooleanList:
+            appendJsonArray(out, *std::any_cast<std::vector<bool>>(&value), append_bool);
+            break;
+        case OptionType::StringList:
+            appendJsonArray(out, *std::any_cast<std::vector<std::string>>(&value), append_string);
+            break;
+        case OptionType::IntList:
+            appendJsonArray(out, *std::any_cast<std::vector<int>>(&value), append_number);
+            break;
+        case OptionType::FloatList:
+            appendJsonArray(out, *std::any_cast<std::vector<float>>(&value), append_number);
+            break;
+        case OptionType::DoubleList:
+            appendJsonArray(out, *std::any_cast<std::vector<double>>(&value), append_number);
+            break;
+    }
+}
+
+/**
+ * @return Name of type in a JSON schema
+ */
+auto jsonTypeName(const OptionType type) -> std::string_view {
+    switch (type) {
+        case OptionType::Boolean:
+            return "boolean";
+        case OptionType::String:
+            return "string";
+        case OptionType::Int:
+            return "int";
+        case OptionType::Float:
+            return "float";
+        case OptionType::Double:
+            return "double";
+        case OptionType::BooleanList:
+            return "boolean list";
+        case OptionType::StringList:
+            return "string list";
+        case OptionType::IntList:
+            return "int list";
+        case OptionType::FloatList:
+            return "float list";
+        case OptionType::DoubleList:
+            return "double list";
+    }
+
+    std::unreachable();
+}
+} // namespace
+
+auto CLI::exportSchema() const -> std::string {
+    std::string out;
+    appendBinary(out, SCHEMA_MAGIC);
+    appendSchema(out);
+
+    return out;
+}
+
+auto CLI::exportSchemaJson() const -> std::string {
+    std::string out;
+    appendSchemaJson(out);
+
+    return out;
+}
+
+auto CLI::loadSchema(const std::string_view schema, const std::map<std::string, Command *, std::less<>> &commands)
+    -> std::expected<void, std::error_code> {
+    assert_message(_options.empty() && _commands.empty(), "Cannot load a schema in a cli already configured");
+
+    BinaryReader reader(schema);
+    if (reader.read<uint32_t>() != SCHEMA_MAGIC) {
+        return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+    }
+    if (auto result = readSchema(reader, commands, ""); ! result.has_value()) {
+        return result;
+    }
+    if (! reader.empty()) {
+        return std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+    }
+
+    return {};
+}
+
+auto CLI::loadSchemaFile(const std::string &path, const std::map<std::string, Command *, std::less<>> &commands)
+    -> std::expected<void, std::error_code> {
+    const auto schema = mapFile(path);
+    if (! schema.has_value()) {
+        return std::unexpected(schema.error());
+    }
+    // Everything is copied out of the mapping while loading
+    auto result = loadSchema(schema.value(), commands);
+    unmapFile(schema.value());
+
+    return result;
+}
+
+auto CLI::appendSchema(std::string &out) const -> void {
+    appendBinaryString(out, _name);
+    appendBinaryString(out, _description);
+    if (! _mode.has_value()) {
+        appendBinary(out, uint8_t{0});
+    } else {
+        appendBinary(out, _mode.value() == Mode::OPTIONS ? SCHEMA_MODE_OPTIONS : SCHEMA_MODE_COMMANDS);
+    }
+
+    appendBinary(out, static_cast<uint32_t>(_groups.size()));
+    for (const auto &[group_name, group] : _groups) {
+        appendBinaryString(out, group_name);
+        appendBinary(out, static_cast<uint32_t>(group._options.size()));
+        for (const auto &option : group._options) {
+            appendBinaryString(out, option->name);
+            appendBinaryString(out, option->short_name);
+            appendBinaryString(out, option->description);
+            appendBinary(out, static_cast<uint8_t>(option->type));
+            appendBinary(out, static_cast<uint8_t>(option->configuration.required));
+            appendBinaryString(out, option->configuration.value_help);
+            appendBinaryString(out, option->configuration.env);
+            appendSchemaValue(out, option->configuration.default_value, option->type);
+            appendSchemaValue(out, option->configuration.implicit_value, option->type);
+        }
+    }
+
+    appendBinary(out, static_cast<uint32_t>(_positional_options.size()));
+    for (const auto &name : _positional_options) {
+        appendBinaryString(out, name);
+    }
+
+    appendBinary(out, static_cast<uint32_t>(_commands_cli.size()));
+    for (const auto &[name, command_cli] : _commands_cli) {
+        appendBinaryString(out, name);
+        command_cli.appendSchema(out);
+    }
+}
+
+auto CLI::appendSchemaJson(std::string &out) const -> void {
+    out += "{\"name\": ";
+    appendJsonString(out, _name);
+    out += ", \"description\": ";
+    appendJsonString(out, _description);
+
+    out += ", \"options\": [";
+    bool first = true;
+    for (const auto &[group_name, group] : _groups) {
+        for (const auto &option : group._options) {
+            out += first ? "{" : ", {";
+            first = false;
+            out += "\"name\": ";
+            appendJsonString(out, option->name);
+            out += ", \"short_name\": ";
+            appendJsonString(out, option->short_name);
+            out += ", \"description\": ";
+            appendJsonString(out, option->description);
+            out += ", \"group\": ";
+            appendJsonString(out, group_name);
+            out += ", \"type\": ";
+            appendJsonString(out, jsonTypeName(option->type));
+            out += ", \"required\": ";
+            out += option->configuration.required ? "true" : "false";
+            out += ", \"value_help\": ";
+            appendJsonString(out, option->configuration.value_help);
+            out += ", \"env\": ";
+            appendJsonString(out, option->configuration.env);
+            for (const auto &[key, value] : {
+                   std::pair{", \"default_value\": ", &option->configuration.default_value},
+                   std::pair{", \"implicit_value\": ", &option->configuration.implicit_value},
+                 }) {
+                if (isExportedValue(*value, option->type)) {
+                    out += key;
+                    appendJsonValue(out, value->value());
+                }
+            }
+            out += '}';
+        }
+    }
+
+    out += "], \"positional\": [";
+    for (size_t i = 0; i < _positional_options.size(); i++) {
+        if (i > 0) {
+            out += ", ";
+        }
+        appendJsonString(out, _positional_options[i]);
+    }
+
+    out += "], \"commands\": [";
+    first = true;
+    for (const auto &command_cli : _commands_cli | std::views::values) {
+        if (! first) {
+            out += ", ";
+        }
+        first = false;
+        command_cli.appendSchemaJson(out);
+    }
+    out += "]}";
+}
+
+auto CLI::readSchema(
+    BinaryReader &reader, const std::map<std::string, Command *, std::less<>> &commands, const std::string &path
+) -> std::expected<void, std::error_code> {
+    const auto invalid = std::unexpected(std::make_error_code(std::errc::illegal_byte_sequence));
+    // Read well, but describing a CLI addOption and addCommand would refuse to build
+    const auto inconsistent = std::unexpected(make_error_code(FaultType::InvalidSchema));
+    _help.invalidate();
+    _option_prefixes.invalidate();
+    _command_prefixes.invalidate();
+    _fingerprint.invalidate();
+
+    const auto name        = reader.readString();
+    const auto description = reader.readString();
+    const auto mode        = reader.read<uint8_t>();
+    if (! name.has_value() || ! description.has_value() || ! mode.has_value() || mode.value() > SCHEMA_MODE_COMMANDS) {
+        return invalid;
+    }
+    _name        = name.value();
+    _description = description.value();
+    if (mode.value() == SCHEMA_MODE_OPTIONS) {
+        _mode = Mode::OPTIONS;
+    } else if (mode.value() == SCHEMA_MODE_COMMANDS) {
+        _mode = Mode::COMMANDS;
+    }
+
+    const auto group_count = reader.read<uint32_t>();
+    if (! group_count.has_value()) {
+        return invalid;
+    }
+    for (uint32_t i = 0; i < group_count.value(); i++) {
+        const auto group_name   = reader.readString();
+        const auto option_count = reader.read<uint32_t>();
+        if (! group_name.has_value() || ! option_count.has_value()) {
+            return invalid;
+        }
+        auto &group = _groups.try_emplace(std::string(group_name.value()), this, std::string(group_name.value()))
+                          .first->second;
+
+        for (uint32_t j = 0; j < option_count.value(); j++) {
+            if (_mode != Mode::OPTIONS) {
+                return inconsistent;
+            }
+            auto read_option = readSchemaOption(reader);
+            if (! read_option.has_value()) {
+                return std::unexpected(read_option.error());
+            }
+            const auto option = std::make_shared<const Option>(std::move(read_option.value()));
+            if (_options.contains(option->name)
+                || (! option->short_name.empty() && _short_options.contains(option->short_name))
+                || (! option->configuration.env.empty() && _env_options.contains(option->configuration.env))) {
+                return inconsistent;
+            }
+            _options.emplace(option->name, option);
+            if (! option->short_name.empty()) {
+                _short_options.emplace(option->short_name, option);
+            }
+            if (! option->configuration.env.empty()) {
+                _env_options.emplace(option->configuration.env, option);
+            }
+            group._options.push_back(option);
+        }
+    }
+
+    const auto positional_count = reader.read<uint32_t>();
+    if (! positional_count.has_value()) {
+        return invalid;
+    }
+    for (uint32_t i = 0; i < positional_count.value(); i++) {
+        if (_mode != Mode::OPTIONS) {
+            return inconsistent;
+        }
+        const auto option_name = reader.readString();
+        if (! option_name.has_value()) {
+            return invalid;
+        }
+        if (! _options.contains(option_name.value())) {
+            return inconsistent;
+        }
+        _positional_options.emplace_back(option_name.value());
+    }
+
+    const auto command_count = reader.read<uint32_t>();
+    if (! command_count.has_value()) {
+        return invalid;
+    }
+    for (uint32_t i = 0; i < command_count.value(); i++) {
+        if (_mode != Mode::COMMANDS) {
+            return inconsistent;
+        }
+        const auto command_name = reader.readString();
+        if (! command_name.has_value()) {
+            return invalid;
+        }
+        if (_commands_cli.contains(command_name.value())) {
+            return inconsistent;
+        }
+        const auto command_path =
+            path.empty() ? std::string(command_name.value()) : path + "." + std::string(command_name.value());
+        const auto command = commands.find(command_path);
+        if (command == commands.end()) {
+            return std::unexpected(std::make_error_code(std::errc::invalid_argument));
+        }
+
+        // Built in place, so that its groups know where it is
+        const std::string key(command_name.value());
+        auto &command_cli            = _commands_cli.try_emplace(key, key, "").first->second;
+        command_cli._help_width      = _help_width;
+        command_cli._prefix_matching = _prefix_matching;
+        command_cli._config_file     = _config_file;
+        command_cli._config_section  = _config_section.empty() ? key : _config_section + "." + key;
+        if (auto result = command_cli.readSchema(reader, commands, command_path); ! result.has_value()) {
+            return result;
+        }
+        _commands.emplace(command_name.value(), command->second);
+    }
+
+    return {};
+}
@@ -23,231 +23,738 @@
  */
 #include "utils.h"
 
-#include <regex>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <fcntl.h>
+#include <iostream>
+#include <ranges>
+#include <sys/ioctl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
 
-auto yeschief::join(const std::vector<std::string> &strings, const std::string &delimiter) -> std::string {
-    if (strings.empty()) {
-        return "";
-    }
+auto yeschief::join(const std::vector<std::string> &strings, const std::string_view delimiter) -> std::string {
+    std::string result;
+    appendJoined(result, strings, delimiter);
 
-    std::string result = *strings.begin();
-    for (auto it = std::next(strings.begin()); it != strings.end(); ++it) {
-        result += delimiter + *it;
+    return result;
+}
+
+auto yeschief::split(const std::string_view str, const std::string_view delimiter) -> std::vector<std::string_view> {
+    std::vector<std::string_view> result;
+    for (const auto part : splitView(str, delimiter)) {
+        result.push_back(part);
     }
 
     return result;
 }
 
-auto yeschief::split(const std::string &str, const std::string &delimiter) -> std::vector<std::string> {
-    const std::regex split_regex(delimiter);
-    std::sregex_token_iterator iter(str.begin(), str.end(), split_regex, -1);
-    const std::sregex_token_iterator end;
-    std::vector<std::string> result;
-    while (iter != end) {
-        std::string current = *iter++;
-        if (current.empty()) {
-            continue;
+auto yeschief::inArray(const std::vector<std::string> &array, const std::string_view needle) -> bool {
+    return std::find(array.begin(), array.end(), needle) != array.end();
+}
+
+auto yeschief::PrefixIndex::build() -> void {
+    std::ranges::sort(_names);
+    _names.erase(std::ranges::unique(_names).begin(), _names.end());
+
+    // Built breadth first, so that the children of a node are added next to each other
+    // The root is reached from no character, its label is never read
+    _nodes.push_back({
+      .begin       = 0,
+      .end         = static_cast<uint32_t>(_names.size()),
+      .first_child = 0,
+      .child_count = 0,
+      .label       = '\0',
+    });
+    std::vector<size_t> depths = {0};
+    for (size_t i = 0; i < _nodes.size(); i++) {
+        const auto depth = depths[i];
+        auto begin       = _nodes[i].begin;
+        const auto end   = _nodes[i].end;
+        // Shorter than the children, the name ending at this node is the first one
+        if (begin < end && _names[begin].size() == depth) {
+            begin++;
+        }
+
+        _nodes[i].first_child = static_cast<uint32_t>(_nodes.size());
+        while (begin < end) {
+            const auto label = static_cast<unsigned char>(_names[begin][depth]);
+            auto child_end   = begin + 1;
+            while (child_end < end && static_cast<unsigned char>(_names[child_end][depth]) == label) {
+                child_end++;
+            }
+            _nodes.push_back({.begin = begin, .end = child_end, .first_child = 0, .child_count = 0, .label = label});
+            depths.push_back(depth + 1);
+            begin = child_end;
         }
-        result.push_back(current);
+        _nodes[i].child_count = static_cast<uint32_t>(_nodes.size()) - _nodes[i].first_child;
     }
+}
 
-    return result;
+auto yeschief::PrefixIndex::find(const std::string_view prefix) const -> std::span<const std::string> {
+    const Node *node = _nodes.data();
+    for (const auto c : prefix) {
+        const auto children = std::span(_nodes).subspan(node->first_child, node->child_count);
+        const auto label    = static_cast<unsigned char>(c);
+        const auto child    = std::ranges::lower_bound(children, label, {}, &Node::label);
+        if (child == children.end() || child->label != label) {
+            return {};
+        }
+        node = &*child;
+    }
+
+    return std::span(_names).subspan(node->begin, node->end - node->begin);
 }
 
-auto yeschief::inArray(const std::vector<std::string> &array, const std::string &needle) -> bool {
-    return std::find(array.begin(), array.end(), needle) != array.end();
+yeschief::EditDistance::EditDistance(const std::string_view pattern): _length(pattern.size()) {
+    assert_message(pattern.size() <= MAX_PATTERN_LENGTH, "Pattern is too long");
+    for (size_t i = 0; i < pattern.size(); i++) {
+        _positions[static_cast<unsigned char>(pattern[i])] |= uint64_t{1} << i;
+    }
+}
+
+auto yeschief::EditDistance::to(const std::string_view text) const -> size_t {
+    if (_length == 0) {
+        return text.size();
+    }
+
+    // Vertical deltas of the current column, +1 (positive) or -1 (negative), starting from the first column 0..m
+    uint64_t positive   = ~uint64_t{0};
+    uint64_t negative   = 0;
+    const uint64_t last = uint64_t{1} << (_length - 1);
+    auto score          = _length;
+    for (const auto c : text) {
+        const auto equal = _positions[static_cast<unsigned char>(c)];
+        const auto xv    = equal | negative;
+        const auto xh    = (((equal & positive) + positive) ^ positive) | equal;
+        // Horizontal deltas
+        auto horizontal_positive = negative | ~(xh | positive);
+        auto horizontal_negative = positive & xh;
+        if ((horizontal_positive & last) != 0) {
+            score++;
+        } else if ((horizontal_negative & last) != 0) {
+            score--;
+        }
+        // The first row is the distance from the empty pattern, it grows by 1 with each character
+        horizontal_positive = (horizontal_positive << 1) | 1;
+        horizontal_negative <<= 1;
+        positive = horizontal_negative | ~(xv | horizontal_positive);
+        negative = horizontal_positive & xv;
+    }
+
+    return score;
+}
+
+auto yeschief::scanEnvironment(const std::function<void(std::string_view name, std::string_view value)> &found)
+    -> void {
+    for (char **variable = environ; variable != nullptr && *variable != nullptr; variable++) {
+        const std::string_view entry(*variable);
+        if (const auto equal = entry.find('='); equal != std::string_view::npos) {
+            found(entry.substr(0, equal), entry.substr(equal + 1));
+        }
+    }
 }
 
 auto yeschief::parseArgv(const int argc, char **argv, const std::vector<std::string> &allowed_options)
     -> std::expected<ArgvParsingResult, Fault> {
-    auto count     = argc;
-    auto arguments = argv;
-    std::map<std::string, std::vector<std::string>> raw_results;
-    std::vector<std::string> option_order;
-    std::vector<std::string> positional_arguments;
-
-    std::optional<std::string> current_option = std::nullopt;
-    bool in_positional                        = false;
-    while (count > 0) {
-        const auto argument = std::string(arguments[0]);
-        if (in_positional) {
-            positional_arguments.push_back(argument);
-        } else {
-            std::smatch match;
-            if (std::regex_match(argument, match, std::regex("^--([^=]+)=([^=]+)$"))
-                || std::regex_match(argument, match, std::regex("^-([^=-])=([^=]+)$"))) {
-                if (! positional_arguments.empty()) {
-                    return std::unexpected<Fault>({
-                      .message = "Unrecognized option: " + positional_arguments[0],
-                      .type    = FaultType::UnrecognizedOption,
-                    });
-                }
+    ArgvParsingState state;
+    for (int i = 0; i < argc; i++) {
+        if (const auto result = parseArgument(argv[i], allowed_options, state); ! result.has_value()) {
+            return std::unexpected(result.error());
+        }
+    }
+    endParsing(state);
 
-                if (current_option.has_value()) {
-                    raw_results.at(current_option.value()).emplace_back("true");
-                }
+    return std::move(state.result);
+}
 
-                const std::string option = match[1];
-                if (! inArray(allowed_options, option)) {
-                    return std::unexpected<Fault>({
-                      .message = "Unrecognized option: " + option,
-                      .type    = FaultType::UnrecognizedOption,
-                    });
-                }
-                if (! raw_results.contains(option)) {
-                    raw_results.emplace(option, std::vector<std::string>());
-                }
+namespace {
+/**
+ * Remove surrounding quotes of a value (`'value'` or `"value"`)
+ */
+auto unquote(const std::string_view value) -> std::string_view {
+    if (value.size() >= 2 && (value.front() == '\'' || value.front() == '"') && value.back() == value.front()) {
+        const auto inner = value.substr(1, value.size() - 2);
+        if (inner.find_first_of("\r\n") == std::string_view::npos) {
+            return inner;
+        }
+    }
 
-                std::string value = match[2];
-                if (std::smatch value_match; std::regex_match(value, value_match, std::regex("^(['\"])(.*)\\1$"))) {
-                    value = value_match[2];
-                }
+    return value;
+}
 
-                raw_results.at(option).push_back(value);
-                option_order.push_back(option);
-                current_option = std::nullopt;
-            }
+/**
+ * A value given with `=` is not empty and does not contain another `=`
+ */
+auto isEqualValue(const std::string_view value) -> bool {
+    return ! value.empty() && value.find('=') == std::string_view::npos;
+}
 
-            else if (std::regex_match(argument, match, std::regex("^--([^=]+)$"))
-                     || std::regex_match(argument, match, std::regex("^-([^=-])$"))) {
-                if (! positional_arguments.empty()) {
-                    return std::unexpected<Fault>({
-                      .message = "Unrecognized option: " + positional_arguments[0],
-                      .type    = FaultType::UnrecognizedOption,
-                    });
-                }
+auto isDigits(const std::string_view value) -> bool {
+    return ! value.empty() && std::ranges::all_of(value, [](const char c) {
+        return c >= '0' && c <= '9';
+    });
+}
 
-                if (current_option.has_value()) {
-                    raw_results.at(current_option.value()).emplace_back("true");
-                }
+/**
+ * Match `[+-]?[0-9]+`
+ */
+auto isInteger(std::string_view value) -> bool {
+    if (value.starts_with('+') || value.starts_with('-')) {
+        value.remove_prefix(1);
+    }
 
-                const std::string option = match[1];
-                if (! inArray(allowed_options, option)) {
-                    return std::unexpected<Fault>({
-                      .message = "Unrecognized option: " + option,
-                      .type    = FaultType::UnrecognizedOption,
-                    });
-                }
-                current_option = option;
-                if (! raw_results.contains(option)) {
-                    raw_results.emplace(option, std::vector<std::string>());
-                }
-                option_order.push_back(option);
+    return isDigits(value);
+}
+
+/**
+ * Match `[+-]?([0-9]*[.])?[0-9]+`
+ */
+auto isDecimal(std::string_view value) -> bool {
+    if (value.starts_with('+') || value.starts_with('-')) {
+        value.remove_prefix(1);
+    }
+    if (const auto dot = value.find('.'); dot != std::string_view::npos) {
+        return (dot == 0 || isDigits(value.substr(0, dot))) && isDigits(value.substr(dot + 1));
+    }
+
+    return isDigits(value);
+}
+
+/**
+ * Convert a number already checked by `isInteger` or `isDecimal`, it fails only when value is out of range
+ */
+template<typename T> auto fromChars(std::string_view value) -> std::optional<T> {
+    if (value.starts_with('+')) {
+        value.remove_prefix(1);
+    }
+    T result;
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), result);
+    if (error != std::errc() || end != value.data() + value.size()) {
+        return std::nullopt;
+    }
+
+    return result;
+}
+
+auto unrecognizedOption(const std::string_view option) -> std::unexpected<yeschief::Fault> {
+    return std::unexpected<yeschief::Fault>({
+      .type  = yeschief::FaultType::UnrecognizedOption,
+      .token = option,
+    });
+}
+
+auto invalidType(const std::string_view value, const std::string_view expected_type)
+    -> std::unexpected<yeschief::Fault> {
+    return std::unexpected<yeschief::Fault>({
+      .type          = yeschief::FaultType::InvalidOptionType,
+      .token         = value,
+      .expected_type = expected_type,
+    });
+}
+} // namespace
+
+auto yeschief::parseArgument(
+    const std::string_view argument,
+    const std::vector<std::string> &allowed_options,
+    ArgvParsingState &state,
+    const std::function<const PrefixIndex *()> &prefixes
+) -> std::expected<void, Fault> {
+    const std::function is_allowed = [&allowed_options](const std::string_view option) {
+        return inArray(allowed_options, option);
+    };
+
+    return parseArgument(argument, is_allowed, state, prefixes);
+}
+
+auto yeschief::parseArgument(
+    std::string_view argument,
+    const std::function<bool(std::string_view option)> &is_allowed,
+    ArgvParsingState &state,
+    const std::function<const PrefixIndex *()> &prefixes
+) -> std::expected<void, Fault> {
+    if (state.keep_arguments) {
+        argument = state.kept_arguments.emplace_back(argument);
+    }
+    auto &[raw_results, option_order, positional_arguments] = state.result;
+    auto &current_option                                    = state.current_option;
+
+    // Give a new option, the previous one waiting for a value is set to "true". Only long options may be prefixes
+    const auto open_option = [&](std::string_view option, const bool is_long) -> std::expected<void, Fault> {
+        if (current_option.has_value()) {
+            raw_results.find(current_option.value())->second.emplace_back("true");
+            current_option = std::nullopt;
+        }
+        if (! is_allowed(option)) {
+            const auto index = is_long && prefixes != nullptr ? prefixes() : nullptr;
+            if (index == nullptr) {
+                return unrecognizedOption(option);
+            }
+            const auto names = index->find(option);
+            if (names.empty()) {
+                return unrecognizedOption(option);
             }
+            if (names.size() > 1) {
+                return std::unexpected<Fault>({
+                  .type       = FaultType::AmbiguousPrefix,
+                  .token      = option,
+                  .candidates = {names.begin(), names.end()},
+                });
+            }
+            option = names.front();
+        }
+        if (! raw_results.contains(option)) {
+            raw_results.emplace(option, std::pmr::vector<std::string_view>());
+        }
+        option_order.push_back(option);
+        current_option = option;
 
-            else if (std::regex_match(argument, match, std::regex("^-([^=-]+)(=[^=]+)?$"))) {
-                if (! positional_arguments.empty()) {
-                    return std::unexpected<Fault>({
-                      .message = "Unrecognized option: " + positional_arguments[0],
-                      .type    = FaultType::UnrecognizedOption,
-                    });
-                }
+        return {};
+    };
+    const auto set_value = [&](const std::string_view value) {
+        raw_results.find(current_option.value())->second.emplace_back(value);
+        current_option = std::nullopt;
+    };
 
-                const std::string options = match[1];
-                for (const char option_char : options) {
-                    if (current_option.has_value()) {
-                        raw_results.at(current_option.value()).emplace_back("true");
-                    }
-
-                    const auto option = std::string(1, option_char);
-                    if (! inArray(allowed_options, option)) {
-                        return std::unexpected<Fault>({
-                          .message = "Unrecognized option: " + option,
-                          .type    = FaultType::UnrecognizedOption,
-                        });
-                    }
-                    current_option = option;
-                    if (! raw_results.contains(option)) {
-                        raw_results.emplace(option, std::vector<std::string>());
-                    }
-                    option_order.push_back(option);
-                }
+    if (state.in_positional) {
+        positional_arguments.emplace_back(argument);
+        return {};
+    }
 
-                if (match[2].matched) {
-                    std::string value = match[2].str().substr(1);
-                    if (std::smatch value_match; std::regex_match(value, value_match, std::regex("^(['\"])(.*)\\1$"))) {
-                        value = value_match[2];
-                    }
-                    raw_results.at(current_option.value()).push_back(value);
-                    current_option = std::nullopt;
-                }
+    if (argument == "--") {
+        if (current_option.has_value()) {
+            set_value("true");
+        }
+        state.in_positional = true;
+        return {};
+    }
+
+    // --name or --name=value
+    if (argument.starts_with("--")) {
+        const auto option = argument.substr(2);
+        const auto equal  = option.find('=');
+        if ((equal == std::string_view::npos && ! option.empty())
+            || (equal != std::string_view::npos && equal > 0 && isEqualValue(option.substr(equal + 1)))) {
+            if (! positional_arguments.empty()) {
+                return unrecognizedOption(positional_arguments[0]);
+            }
+            if (const auto opened = open_option(option.substr(0, equal), true); ! opened.has_value()) {
+                return opened;
             }
+            if (equal != std::string_view::npos) {
+                set_value(unquote(option.substr(equal + 1)));
+            }
+            return {};
+        }
+    }
 
-            else if (argument == "--") {
-                if (current_option.has_value()) {
-                    raw_results.at(current_option.value()).emplace_back("true");
-                    current_option = std::nullopt;
+    // -n, -n=value, -abc or -abc=value
+    else if (argument.starts_with('-')) {
+        const auto equal   = argument.find('=');
+        const auto options = argument.substr(1, equal == std::string_view::npos ? equal : equal - 1);
+        if (! options.empty() && options.find('-') == std::string_view::npos
+            && (equal == std::string_view::npos || isEqualValue(argument.substr(equal + 1)))) {
+            if (! positional_arguments.empty()) {
+                return unrecognizedOption(positional_arguments[0]);
+            }
+            for (size_t i = 0; i < options.size(); i++) {
+                if (const auto opened = open_option(options.substr(i, 1), false); ! opened.has_value()) {
+                    return opened;
                 }
-                in_positional = true;
             }
+            if (equal != std::string_view::npos) {
+                set_value(unquote(argument.substr(equal + 1)));
+            }
+            return {};
+        }
+    }
 
-            else {
-                if (current_option.has_value()) {
-                    raw_results.at(current_option.value()).push_back(argument);
-                    current_option = std::nullopt;
-                } else {
-                    positional_arguments.push_back(argument);
-                }
+    if (current_option.has_value()) {
+        set_value(argument);
+    } else {
+        positional_arguments.emplace_back(argument);
+    }
+
+    return {};
+}
+
+auto yeschief::endParsing(ArgvParsingState &state) -> void {
+    if (state.current_option.has_value()) {
+        state.result.raw_results.find(state.current_option.value())->second.emplace_back("true");
+        state.current_option = std::nullopt;
+    }
+}
+
+auto yeschief::resetParsing(ArgvParsingState &state) -> void {
+    for (auto &values : state.result.raw_results | std::views::values) {
+        values.clear();
+    }
+    state.result.option_order.clear();
+    state.result.positional_arguments.clear();
+    state.current_option = std::nullopt;
+    state.in_positional  = false;
+    state.kept_arguments.clear();
+}
+
+auto yeschief::scanConfig(
+    const std::string_view content,
+    const std::function<std::expected<void, Fault>(std::string_view, std::string_view, std::string_view)> &found
+) -> std::expected<void, Fault> {
+    const auto trim = [](std::string_view str) -> std::string_view {
+        constexpr std::string_view blanks = " \t\r";
+        const auto first                  = str.find_first_not_of(blanks);
+        if (first == std::string_view::npos) {
+            return {};
+        }
+        return str.substr(first, str.find_last_not_of(blanks) - first + 1);
+    };
+
+    std::string_view section;
+    size_t begin = 0;
+    while (begin < content.size()) {
+        const auto end  = std::min(content.find('\n', begin), content.size());
+        const auto line = trim(content.substr(begin, end - begin));
+        begin           = end + 1;
+        if (line.empty() || line.front() == '#' || line.front() == ';') {
+            continue;
+        }
+
+        if (line.front() == '[') {
+            section = line.back() == ']' ? trim(line.substr(1, line.size() - 2)) : std::string_view();
+            if (section.empty()) {
+                return std::unexpected<Fault>({
+                  .type   = FaultType::InvalidConfigFile,
+                  .token  = line,
+                  .source = TokenSource::ConfigFile,
+                });
             }
+            if (auto result = found(section, {}, {}); ! result.has_value()) {
+                return result;
+            }
+            continue;
         }
 
-        count--;
-        arguments++;
+        const auto equal = line.find('=');
+        const auto key   = trim(line.substr(0, equal));
+        if (key.empty()) {
+            return std::unexpected<Fault>({
+              .type   = FaultType::InvalidConfigFile,
+              .token  = line,
+              .source = TokenSource::ConfigFile,
+            });
+        }
+        const auto value =
+            equal == std::string_view::npos ? std::string_view("true") : unquote(trim(line.substr(equal + 1)));
+        if (auto result = found(section, key, value); ! result.has_value()) {
+            return result;
+        }
     }
 
-    if (current_option.has_value()) {
-        raw_results.at(current_option.value()).emplace_back("true");
+    return {};
+}
+
+auto yeschief::mapFile(const std::string &path) -> std::expected<std::string_view, std::error_code> {
+    const auto error = [] {
+        return std::unexpected(std::error_code(errno, std::system_category()));
+    };
+
+    const auto file = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (file < 0) {
+        return error();
+    }
+    struct stat status{};
+    if (fstat(file, &status) != 0) {
+        const auto result = error();
+        close(file);
+        return result;
+    }
+    if (! S_ISREG(status.st_mode)) {
+        close(file);
+        return std::unexpected(std::make_error_code(std::errc::invalid_argument));
     }
 
-    ArgvParsingResult parse_result = {
-      .raw_results          = raw_results,
-      .option_order         = option_order,
-      .positional_arguments = positional_arguments,
+    // An empty file cannot be mapped, it has no content to read anyway
+    const auto size = static_cast<size_t>(status.st_size);
+    if (size == 0) {
+        close(file);
+        return std::string_view();
+    }
+    const auto mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+    if (mapping == MAP_FAILED) {
+        const auto result = error();
+        close(file);
+        return result;
+    }
+    // The mapping stays valid once the file is closed
+    close(file);
+
+    return std::string_view(static_cast<const char *>(mapping), size);
+}
+
+auto yeschief::unmapFile(const std::string_view content) -> void {
+    if (! content.empty()) {
+        munmap(const_cast<char *>(content.data()), content.size());
+    }
+}
+
+auto yeschief::appendBinaryString(std::string &out, const std::string_view str) -> void {
+    appendBinary(out, static_cast<uint32_t>(str.size()));
+    out += str;
+}
+
+namespace {
+template<typename T> auto appendBinaryNumbers(std::string &out, const std::vector<T> &values) -> void {
+    yeschief::appendBinary(out, static_cast<uint32_t>(values.size()));
+    out.append(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(T));
+}
+} // namespace
+
+auto yeschief::optionTypeOfValue(const std::any &value) -> std::optional<OptionType> {
+    if (std::any_cast<bool>(&value) != nullptr) {
+        return OptionType::Boolean;
+    }
+    if (std::any_cast<std::string>(&value) != nullptr) {
+        return OptionType::String;
+    }
+    if (std::any_cast<int>(&value) != nullptr) {
+        return OptionType::Int;
+    }
+    if (std::any_cast<float>(&value) != nullptr) {
+        return OptionType::Float;
+    }
+    if (std::any_cast<double>(&value) != nullptr) {
+        return OptionType::Double;
+    }
+    if (std::any_cast<std::vector<bool>>(&value) != nullptr) {
+        return OptionType::BooleanList;
+    }
+    if (std::any_cast<std::vector<std::string>>(&value) != nullptr) {
+        return OptionType::StringList;
+    }
+    if (std::any_cast<std::vector<int>>(&value) != nullptr) {
+        return OptionType::IntList;
+    }
+    if (std::any_cast<std::vector<float>>(&value) != nullptr) {
+        return OptionType::FloatList;
+    }
+    if (std::any_cast<std::vector<double>>(&value) != nullptr) {
+        return OptionType::DoubleList;
+    }
+
+    return std::nullopt;
+}
+
+auto yeschief::appendBinaryValue(std::string &out, const OptionType type, const std::any &value) -> void {
+    appendBinary(out, static_cast<uint8_t>(type));
+    switch (type) {
+        case OptionType::Boolean:
+            appendBinary(out, static_cast<uint8_t>(*std::any_cast<bool>(&value)));
+            break;
+        case OptionType::String:
+            appendBinaryString(out, *std::any_cast<std::string>(&value));
+            break;
+        case OptionType::Int:
+            appendBinary(out, *std::any_cast<int>(&value));
+            break;
+        case OptionType::Float:
+            appendBinary(out, *std::any_cast<float>(&value));
+            break;
+        case OptionType::Double:
+            appendBinary(out, *std::any_cast<double>(&value));
+            break;
+        case OptionType::BooleanList: {
+            const auto &values = *std::any_cast<std::vector<bool>>(&value);
+            appendBinary(out, static_cast<uint32_t>(values.size()));
+            for (const bool element : values) {
+                appendBinary(out, static_cast<uint8_t>(element));
+            }
+            break;
+        }
+        case OptionType::StringList: {
+            const auto &values = *std::any_cast<std::vector<std::string>>(&value);
+            appendBinary(out, static_cast<uint32_t>(values.size()));
+            for (const auto &element : values) {
+                appendBinaryString(out, element);
+            }
+            break;
+        }
+        case OptionType::IntList:
+            appendBinaryNumbers(out, *std::any_cast<std::vector<int>>(&value));
+            break;
+        case OptionType::FloatList:
+            appendBinaryNumbers(out, *std::any_cast<std::vector<float>>(&value));
+            break;
+        case OptionType::DoubleList:
+            appendBinaryNumbers(out, *std::any_cast<std::vector<double>>(&value));
+            break;
+    }
+}
+
+auto yeschief::BinaryReader::readBool() -> std::optional<bool> {
+    return read<uint8_t>().transform([](const uint8_t value) {
+        return value != 0;
+    });
+}
+
+auto yeschief::BinaryReader::readString() -> std::optional<std::string_view> {
+    const auto size = read<uint32_t>();
+    if (! size.has_value() || _data.size() < size.value()) {
+        return std::nullopt;
+    }
+    const auto str = _data.substr(0, size.value());
+    _data.remove_prefix(size.value());
+
+    return str;
+}
+
+auto yeschief::BinaryReader::readCount(const size_t min_size) -> std::optional<uint32_t> {
+    const auto count = read<uint32_t>();
+    if (! count.has_value() || _data.size() / min_size < count.value()) {
+        return std::nullopt;
+    }
+
+    return count;
+}
+
+auto yeschief::BinaryReader::readValue() -> std::optional<std::any> {
+    const auto to_any = [](auto value) -> std::optional<std::any> {
+        if (! value.has_value()) {
+            return std::nullopt;
+        }
+        return std::move(value.value());
+    };
+
+    const auto type = read<uint8_t>();
+    if (! type.has_value()) {
+        return std::nullopt;
+    }
+    switch (static_cast<OptionType>(type.value())) {
+        case OptionType::Boolean:
+            return to_any(readBool());
+        case OptionType::String:
+            return to_any(readString().transform([](const std::string_view str) {
+                return std::string(str);
+            }));
+        case OptionType::Int:
+            return to_any(read<int>());
+        case OptionType::Float:
+            return to_any(read<float>());
+        case OptionType::Double:
+            return to_any(read<double>());
+        case OptionType::BooleanList:
+            return readList<bool>([this] {
+                return readBool();
+            });
+        case OptionType::StringList:
+            return readList<std::string>([this] {
+                return readString();
+            });
+        case OptionType::IntList:
+            return readNumbers<int>();
+        case OptionType::FloatList:
+            return readNumbers<float>();
+        case OptionType::DoubleList:
+            return readNumbers<double>();
+    }
+
+    // Not written by appendBinaryValue
+    return std::nullopt;
+}
+
+namespace {
+/**
+ * Set while the thread runs a task of `parallelFor`
+ */
+thread_local bool in_parallel_for = false;
+} // namespace
+
+auto yeschief::inParallelFor() -> bool {
+    return in_parallel_for;
+}
+
+auto yeschief::parallelFor(
+    const size_t count,
+    unsigned thread_count,
+    const size_t chunk_size,
+    const std::function<void(unsigned thread_index, size_t begin, size_t end)> &task
+) -> void {
+    thread_count = std::max(1U, std::min(thread_count, static_cast<unsigned>((count + chunk_size - 1) / chunk_size)));
+    // Nested in another parallelFor, all cores are already busy
+    if (thread_count == 1 || in_parallel_for) {
+        if (count > 0) {
+            task(0, 0, count);
+        }
+        return;
+    }
+
+    // Each thread owns a share of indexes. Owner and thieves claim chunks of it with the same atomic cursor
+    struct Share {
+        std::atomic<size_t> next;
+        size_t end;
     };
-    return parse_result;
+    const auto shares = std::make_unique<Share[]>(thread_count);
+    for (unsigned i = 0; i < thread_count; i++) {
+        shares[i].next = count * i / thread_count;
+        shares[i].end  = count * (i + 1) / thread_count;
+    }
+
+    const auto work = [&](const unsigned thread_index) {
+        in_parallel_for = true;
+        for (unsigned k = 0; k < thread_count; k++) {
+            auto &share = shares[(thread_index + k) % thread_count];
+            for (auto begin = share.next.fetch_add(chunk_size); begin < share.end;
+                 begin      = share.next.fetch_add(chunk_size)) {
+                task(thread_index, begin, std::min(begin + chunk_size, share.end));
+            }
+        }
+        in_parallel_for = false;
+    };
+
+    std::vector<std::jthread> threads;
+    threads.reserve(thread_count - 1);
+    for (unsigned i = 1; i < thread_count; i++) {
+        threads.emplace_back(work, i);
+    }
+    work(0);
 }
 
-auto yeschief::toBoolean(const std::string &value) -> std::expected<bool, Fault> {
+auto yeschief::toBoolean(const std::string_view value) -> std::expected<bool, Fault> {
     if (value == "true" || value == "1") {
         return true;
     }
     if (value == "false" || value == "0") {
         return false;
     }
-    return std::unexpected<Fault>({
-      .message = "'" + value + "' cannot be parsed to a boolean value",
-      .type    = FaultType::InvalidOptionType,
-    });
+    return invalidType(value, "boolean");
 }
 
-auto yeschief::toInt(const std::string &value) -> std::expected<int, Fault> {
-    if (std::smatch match; std::regex_match(value, match, std::regex("^[+-]?\\d+$"))) {
-        return std::stoi(value);
+auto yeschief::toInt(const std::string_view value) -> std::expected<int, Fault> {
+    if (isInteger(value)) {
+        if (const auto result = fromChars<int>(value); result.has_value()) {
+            return result.value();
+        }
     }
-    return std::unexpected<Fault>({
-      .message = "'" + value + "' cannot be parsed to an int value",
-      .type    = FaultType::InvalidOptionType,
-    });
+    return invalidType(value, "int");
 }
 
-auto yeschief::toFloat(const std::string &value) -> std::expected<float, Fault> {
-    if (std::smatch match; std::regex_match(value, match, std::regex("^[+-]?([0-9]*[.])?[0-9]+$"))) {
-        return std::stof(value);
+auto yeschief::toFloat(const std::string_view value) -> std::expected<float, Fault> {
+    if (isDecimal(value)) {
+        if (const auto result = fromChars<float>(value); result.has_value()) {
+            return result.value();
+        }
     }
-    return std::unexpected<Fault>({
-      .message = "'" + value + "' cannot be parsed to an int value",
-      .type    = FaultType::InvalidOptionType,
-    });
+    return invalidType(value, "float");
 }
 
-auto yeschief::toDouble(const std::string &value) -> std::expected<double, Fault> {
-    if (std::smatch match; std::regex_match(value, match, std::regex("^[+-]?([0-9]*[.])?[0-9]+$"))) {
-        return std::stod(value);
+auto yeschief::toDouble(const std::string_view value) -> std::expected<double, Fault> {
+    if (isDecimal(value)) {
+        if (const auto result = fromChars<double>(value); result.has_value()) {
+            return result.value();
+        }
     }
-    return std::unexpected<Fault>({
-      .message = "'" + value + "' cannot be parsed to an int value",
-      .type    = FaultType::InvalidOptionType,
-    });
+    return invalidType(value, "double");
 }
 
 auto yeschief::toUpper(const std::string &str) -> std::string {
@@ -257,3 +764,20 @@ auto yeschief::toUpper(const std::string &str) -> std::string {
     }
     return result;
 }
+
+auto yeschief::terminalWidth(const std::ostream &out) -> size_t {
+    int descriptor;
+    if (&out == &std::cout) {
+        descriptor = STDOUT_FILENO;
+    } else if (&out == &std::cerr || &out == &std::clog) {
+        descriptor = STDERR_FILENO;
+    } else {
+        return 0;
+    }
+
+    if (winsize size{}; isatty(descriptor) && ioctl(descriptor, TIOCGWINSZ, &size) == 0) {
+        return size.ws_col;
+    }
+
+    return 0;
+}
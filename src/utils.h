@@ -26,36 +26,535 @@
 
 #include "yeschief.h"
 
+#include <algorithm>
+#include <any>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
 #include <expected>
+#include <functional>
 #include <map>
+#include <memory_resource>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace yeschief {
-auto join(const std::vector<std::string> &strings, const std::string &delimiter = "") -> std::string;
+/**
+ * Append parts to out, separated by delimiter. The size of the result is computed first so out grows at most once
+ */
+template<std::ranges::forward_range Parts>
+auto appendJoined(std::string &out, Parts &&parts, const std::string_view delimiter) -> void {
+    size_t size  = 0;
+    size_t count = 0;
+    for (const auto &part : parts) {
+        size += std::string_view(part).size();
+        count++;
+    }
+    if (count == 0) {
+        return;
+    }
+
+    if (const auto needed = out.size() + size + (count - 1) * delimiter.size(); needed > out.capacity()) {
+        // Still grows geometrically, as out is often appended to many times
+        out.reserve(std::max(needed, 2 * out.capacity()));
+    }
+    bool first = true;
+    for (const auto &part : parts) {
+        if (! first) {
+            out += delimiter;
+        }
+        out += part;
+        first = false;
+    }
+}
+
+template<std::ranges::forward_range Parts>
+auto join(Parts &&parts, const std::string_view delimiter = "") -> std::string {
+    std::string result;
+    appendJoined(result, std::forward<Parts>(parts), delimiter);
+
+    return result;
+}
+
+auto join(const std::vector<std::string> &strings, std::string_view delimiter = "") -> std::string;
+
+/**
+ * Lazy range over the non empty parts of str separated by delimiter, as views into str. It does not allocate
+ */
+inline auto splitView(const std::string_view str, const std::string_view delimiter) {
+    return std::views::split(str, delimiter) | std::views::transform([](const auto &part) {
+               return std::string_view(part.begin(), part.end());
+           })
+         | std::views::filter([](const std::string_view part) {
+               return ! part.empty();
+           });
+}
+
+/**
+ * @return Non empty parts of str separated by delimiter, as views into str
+ */
+auto split(std::string_view str, std::string_view delimiter) -> std::vector<std::string_view>;
+
+auto inArray(const std::vector<std::string> &array, std::string_view needle) -> bool;
+
+/**
+ * Sorted names stored in a trie, to find all names starting with a prefix in O(length of the prefix): the children of
+ * a node are contiguous and each node knows the range of names below it. Names are copied, views returned by `find`
+ * are valid as long as the index is
+ */
+class PrefixIndex final {
+  public:
+    template<std::ranges::input_range Names> explicit PrefixIndex(Names &&names) {
+        for (const auto &name : names) {
+            _names.emplace_back(name);
+        }
+        build();
+    }
+
+    /**
+     * @return Names starting with prefix, in lexicographic order
+     */
+    [[nodiscard]] auto find(std::string_view prefix) const -> std::span<const std::string>;
+
+  private:
+    typedef struct Node {
+        /**
+         * Range of names below this node in `_names`
+         */
+        uint32_t begin;
+        uint32_t end;
+        /**
+         * Range of children of this node in `_nodes`, sorted by label
+         */
+        uint32_t first_child;
+        uint32_t child_count;
+        /**
+         * Character leading from the parent to this node, unsigned to be ordered like strings are
+         */
+        unsigned char label;
+    } Node;
+
+    std::vector<std::string> _names;
+    std::vector<Node> _nodes;
+
+    auto build() -> void;
+};
+
+/**
+ * Edit distance (Levenshtein) from a pattern to any text, with the bit-parallel algorithm of Myers as formulated by
+ * Hyyrö: a whole column of the distance matrix is held in bit vectors of one word, so each character of the text costs
+ * a few word operations. Patterns are limited to 64 characters
+ */
+class EditDistance final {
+  public:
+    static constexpr size_t MAX_PATTERN_LENGTH = 64;
+
+    explicit EditDistance(std::string_view pattern);
+
+    /**
+     * @return Count of insertions, deletions and substitutions turning pattern into text
+     */
+    [[nodiscard]] auto to(std::string_view text) const -> size_t;
+
+  private:
+    /**
+     * For each character, bits set at its positions in pattern
+     */
+    std::array<uint64_t, 256> _positions{};
+    size_t _length;
+};
+
+/**
+ * Maximum count of names suggested by `suggest`
+ */
+constexpr size_t MAX_SUGGESTIONS = 3;
+
+/**
+ * Names close enough to token to be what the user meant: within an edit distance of a third of its length (at least
+ * 1), closest first. Names whose length alone puts them too far are skipped without computing their distance
+ *
+ * @return Up to `MAX_SUGGESTIONS` views on names
+ */
+template<std::ranges::input_range Names>
+auto suggest(const std::string_view token, Names &&names) -> std::vector<std::string_view> {
+    std::vector<std::string_view> suggestions;
+    if (token.size() < 2 || token.size() > EditDistance::MAX_PATTERN_LENGTH) {
+        return suggestions;
+    }
+
+    const EditDistance distance(token);
+    // Only the best names are kept, the worst of them bounds the distance of the next ones once there are enough
+    auto threshold = std::max<size_t>(1, token.size() / 3);
+    std::vector<std::pair<size_t, std::string_view>> best;
+    best.reserve(MAX_SUGGESTIONS + 1);
+    for (const auto &name : names) {
+        const std::string_view view = name;
+        if (std::max(view.size(), token.size()) - std::min(view.size(), token.size()) > threshold) {
+            continue;
+        }
+        const std::pair<size_t, std::string_view> candidate(distance.to(view), view);
+        if (candidate.first > threshold || (best.size() == MAX_SUGGESTIONS && ! (candidate < best.back()))) {
+            continue;
+        }
+        best.insert(std::ranges::upper_bound(best, candidate), candidate);
+        if (best.size() > MAX_SUGGESTIONS) {
+            best.pop_back();
+        }
+        if (best.size() == MAX_SUGGESTIONS) {
+            threshold = best.back().first;
+        }
+    }
 
-auto split(const std::string &str, const std::string &delimiter) -> std::vector<std::string>;
+    for (const auto &name : best | std::views::values) {
+        suggestions.push_back(name);
+    }
 
-auto inArray(const std::vector<std::string> &array, const std::string &needle) -> bool;
+    return suggestions;
+}
+
+/**
+ * Values given for each option. An option with no values has not been given (see `resetParsing`).
+ *
+ * Values, option names and positional arguments are views on the parsed arguments: they are valid as long as these
+ * arguments are (argv for `parseArgv`, `ArgvParsingState::kept_arguments` when it keeps them). This way parsing holds a
+ * single view per argument instead of copies of them
+ */
+typedef struct ArgvParsingResult {
+    explicit ArgvParsingResult(std::pmr::memory_resource *resource = std::pmr::get_default_resource())
+        : raw_results(resource), option_order(resource), positional_arguments(resource) {}
 
-typedef struct {
-    std::map<std::string, std::vector<std::string>> raw_results;
-    std::vector<std::string> option_order;
-    std::vector<std::string> positional_arguments;
+    std::pmr::map<std::pmr::string, std::pmr::vector<std::string_view>, std::less<>> raw_results;
+    std::pmr::vector<std::string_view> option_order;
+    std::pmr::vector<std::string_view> positional_arguments;
 } ArgvParsingResult;
 
+/**
+ * What is kept between two arguments while parsing argv
+ */
+typedef struct ArgvParsingState {
+    /**
+     * @param resource Memory resource of the result and kept arguments
+     * @param keep_arguments Whether parsed arguments are copied in `kept_arguments`, for callers not keeping them alive
+     * until the result is used
+     */
+    explicit ArgvParsingState(
+        std::pmr::memory_resource *resource = std::pmr::get_default_resource(), const bool keep_arguments = false
+    )
+        : result(resource), kept_arguments(resource), keep_arguments(keep_arguments) {}
+
+    // Views of a copy would point to the kept arguments of the original
+    ArgvParsingState(const ArgvParsingState &)                    = delete;
+    auto operator=(const ArgvParsingState &) -> ArgvParsingState & = delete;
+
+    ArgvParsingResult result;
+    /**
+     * Last option given, waiting for a value
+     */
+    std::optional<std::string_view> current_option = std::nullopt;
+    /**
+     * `--` has been given, everything after it is positional
+     */
+    bool in_positional                             = false;
+    /**
+     * Copies of the parsed arguments, in order, when `keep_arguments` is set. A deque never moves its elements so views
+     * on them stay valid
+     */
+    std::pmr::deque<std::pmr::string> kept_arguments;
+    bool keep_arguments;
+} ArgvParsingState;
+
+/**
+ * Parse all arguments of argv. The result holds views on argv
+ */
 auto parseArgv(int argc, char **argv, const std::vector<std::string> &allowed_options)
     -> std::expected<ArgvParsingResult, Fault>;
 
-auto toBoolean(const std::string &value) -> std::expected<bool, Fault>;
+/**
+ * Parse a single argument and update state accordingly. When it returns a Fault, state may have been partially updated.
+ *
+ * Unless state keeps arguments, argument must stay alive as long as state result is used. When prefixes is given, a
+ * long option not allowed is looked up as a prefix in the index it returns, if any: the option is then named after the
+ * name found in it. prefixes is only called for such an option, an index built on demand costs nothing to exact names
+ */
+auto parseArgument(
+    std::string_view argument,
+    const std::vector<std::string> &allowed_options,
+    ArgvParsingState &state,
+    const std::function<const PrefixIndex *()> &prefixes = nullptr
+) -> std::expected<void, Fault>;
+
+/**
+ * Same as above, an option being allowed when is_allowed returns true for its name (long or short, without dashes).
+ * This way a CLI looks options up in its own index instead of scanning a list of names
+ */
+auto parseArgument(
+    std::string_view argument,
+    const std::function<bool(std::string_view option)> &is_allowed,
+    ArgvParsingState &state,
+    const std::function<const PrefixIndex *()> &prefixes = nullptr
+) -> std::expected<void, Fault>;
+
+/**
+ * Close the parsing: an option still waiting for a value receives "true"
+ */
+auto endParsing(ArgvParsingState &state) -> void;
+
+/**
+ * Make state ready for a new parsing while keeping its buffers allocated. Known options stay in `raw_results` with an
+ * empty list of values
+ */
+auto resetParsing(ArgvParsingState &state) -> void;
+
+/**
+ * @return 64 bits FNV-1a hash of bytes, the same in every process
+ */
+constexpr auto hashBytes(const std::string_view bytes) -> uint64_t {
+    uint64_t hash = 0xcbf29ce484222325;
+    for (const auto byte : bytes) {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= 0x100000001b3;
+    }
+
+    return hash;
+}
+
+/**
+ * Call found with the name and value of each variable of the environment, in a single scan of it. Views are on the
+ * environment itself
+ */
+auto scanEnvironment(const std::function<void(std::string_view name, std::string_view value)> &found) -> void;
+
+/**
+ * Call found with the section, key and value of each entry of a config file content (see `ConfigFile`), in order, and
+ * with an empty key and value at the start of each section. Views are on content, the value of a key alone is `true`
+ *
+ * @return The first Fault found returns, or an `InvalidConfigFile` one on the first line that is neither an entry, a
+ * section nor a comment
+ */
+auto scanConfig(
+    std::string_view content,
+    const std::function<std::expected<void, Fault>(std::string_view, std::string_view, std::string_view)> &found
+) -> std::expected<void, Fault>;
+
+/**
+ * Map the whole file at path in memory, read-only. The file is closed, its mapping stays valid until `unmapFile`
+ *
+ * @return Content of the file, or the error of the system when it cannot be read
+ */
+auto mapFile(const std::string &path) -> std::expected<std::string_view, std::error_code>;
+
+/**
+ * @param content Content returned by `mapFile`
+ */
+auto unmapFile(std::string_view content) -> void;
+
+/**
+ * Append the bytes of value to out, as they are in memory
+ */
+template<typename T> auto appendBinary(std::string &out, const T &value) -> void {
+    static_assert(std::is_trivially_copyable_v<T>);
+    out.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Append the size of str then str to out
+ */
+auto appendBinaryString(std::string &out, std::string_view str) -> void;
+
+/**
+ * @return OptionType of the value held by value, nothing if options cannot have this type
+ */
+auto optionTypeOfValue(const std::any &value) -> std::optional<OptionType>;
+
+/**
+ * Append type then the value held by value to out. Numbers are written as they are in memory, a list of them in a
+ * single block
+ *
+ * @param type OptionType of value, see `optionTypeOfValue`
+ */
+auto appendBinaryValue(std::string &out, OptionType type, const std::any &value) -> void;
+
+/**
+ * Reads what `appendBinary`, `appendBinaryString` and `appendBinaryValue` wrote, from the start of data. Each read
+ * fails once data is exhausted or invalid
+ */
+class BinaryReader final {
+  public:
+    explicit BinaryReader(const std::string_view data): _data(data) {}
+
+    template<typename T> auto read() -> std::optional<T> {
+        static_assert(std::is_trivially_copyable_v<T>);
+        if (_data.size() < sizeof(T)) {
+            return std::nullopt;
+        }
+        T value;
+        std::memcpy(&value, _data.data(), sizeof(T));
+        _data.remove_prefix(sizeof(T));
+
+        return value;
+    }
+
+    auto readBool() -> std::optional<bool>;
+
+    /**
+     * @return View on data
+     */
+    auto readString() -> std::optional<std::string_view>;
+
+    auto readValue() -> std::optional<std::any>;
 
-auto toInt(const std::string &value) -> std::expected<int, Fault>;
+    [[nodiscard]] auto empty() const -> bool {
+        return _data.empty();
+    }
 
-auto toFloat(const std::string &value) -> std::expected<float, Fault>;
+  private:
+    std::string_view _data;
 
-auto toDouble(const std::string &value) -> std::expected<double, Fault>;
+    /**
+     * @return Count of elements of a list, nothing if data is too short to hold them with at least min_size bytes each
+     */
+    auto readCount(size_t min_size) -> std::optional<uint32_t>;
+
+    template<typename T> auto readNumbers() -> std::optional<std::any> {
+        const auto count = readCount(sizeof(T));
+        if (! count.has_value()) {
+            return std::nullopt;
+        }
+        std::vector<T> values(count.value());
+        if (values.empty()) {
+            // data() of an empty vector may be null, which memcpy does not accept even for 0 bytes
+            return values;
+        }
+        std::memcpy(values.data(), _data.data(), values.size() * sizeof(T));
+        _data.remove_prefix(values.size() * sizeof(T));
+
+        return values;
+    }
+
+    template<typename T, typename ReadElement> auto readList(ReadElement &&read_element) -> std::optional<std::any> {
+        const auto count = readCount(1);
+        if (! count.has_value()) {
+            return std::nullopt;
+        }
+        std::vector<T> values;
+        values.reserve(count.value());
+        for (uint32_t i = 0; i < count.value(); i++) {
+            auto value = read_element();
+            if (! value.has_value()) {
+                return std::nullopt;
+            }
+            values.emplace_back(std::move(value.value()));
+        }
+
+        return values;
+    }
+};
+
+/**
+ * Call task on all indexes of [0, count[ spread across thread_count threads. Each thread starts with its own share of
+ * indexes, cut into chunks of chunk_size, then steals chunks from the others when it is done with its own.
+ *
+ * task receives the thread index (in [0, thread_count[) and a range [begin, end[ of indexes to process. When called
+ * from a task of another parallelFor, all indexes are processed by the calling thread, as thread 0
+ */
+auto parallelFor(
+    size_t count,
+    unsigned thread_count,
+    size_t chunk_size,
+    const std::function<void(unsigned thread_index, size_t begin, size_t end)> &task
+) -> void;
+
+/**
+ * @return Whether the calling thread is running a task of `parallelFor`
+ */
+auto inParallelFor() -> bool;
+
+/**
+ * Set the `argument_index` of fault to the index of the argument its token is a view on, arguments[i] having the index
+ * first_index + i. Only pointers are compared, an argument is read only to check the token is inside it
+ */
+template<typename Arguments>
+auto locateArgument(Fault &fault, const Arguments &arguments, const size_t first_index) -> void {
+    if (fault.token.empty() || fault.argument_index.has_value()) {
+        return;
+    }
+
+    // The argument containing token is the one starting the closest before it
+    constexpr std::less<const char *> before;
+    const char *const token = fault.token.data();
+    const char *closest     = nullptr;
+    size_t closest_index    = 0;
+    size_t index            = 0;
+    for (const auto &argument : arguments) {
+        const char *data;
+        if constexpr (std::is_pointer_v<std::remove_cvref_t<decltype(argument)>>) {
+            data = argument;
+        } else {
+            data = argument.data();
+        }
+        if (! before(token, data) && (closest == nullptr || before(closest, data))) {
+            closest       = data;
+            closest_index = index;
+        }
+        index++;
+    }
+
+    if (closest != nullptr && before(token, closest + std::string_view(closest).size() + 1)) {
+        fault.argument_index = first_index + closest_index;
+    }
+}
+
+/**
+ * Add the time spent in its scope to a phase of profile. It does nothing when profile is null
+ */
+class PhaseTimer final {
+  public:
+    PhaseTimer(RunProfile *profile, const ProfilePhase phase): _profile(profile), _phase(phase) {
+        if (_profile != nullptr) {
+            _start = std::chrono::steady_clock::now();
+        }
+    }
+
+    PhaseTimer(const PhaseTimer &)                    = delete;
+    auto operator=(const PhaseTimer &) -> PhaseTimer & = delete;
+
+    ~PhaseTimer() {
+        if (_profile != nullptr) {
+            _profile->durations[static_cast<size_t>(_phase)] += std::chrono::steady_clock::now() - _start;
+        }
+    }
+
+  private:
+    RunProfile *_profile;
+    ProfilePhase _phase;
+    std::chrono::steady_clock::time_point _start;
+};
+
+auto toBoolean(std::string_view value) -> std::expected<bool, Fault>;
+
+auto toInt(std::string_view value) -> std::expected<int, Fault>;
+
+auto toFloat(std::string_view value) -> std::expected<float, Fault>;
+
+auto toDouble(std::string_view value) -> std::expected<double, Fault>;
 
 auto toUpper(const std::string &str) -> std::string;
+
+/**
+ * @return Count of columns of the terminal out writes to, 0 if it is not one. Only `std::cout` (STDOUT) and
+ * `std::cerr` or `std::clog` (STDERR) can be one
+ */
+auto terminalWidth(const std::ostream &out) -> size_t;
 } // namespace yeschief
 
 #endif // UTILS_H
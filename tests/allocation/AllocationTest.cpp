@@ -0,0 +1,207 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "../../src/utils.h"
+#include "../unit/test_tools.hpp"
+#include "allocation_counter.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <yeschief.h>
+
+/*
+ * Upper bounds of heap allocations made by the parse hot path. They are a bit above current counts: when a change
+ * makes one of these tests fail, either find where the new allocations come from or raise the bound knowingly
+ */
+
+namespace {
+auto flagsCLI() -> yeschief::CLI {
+    yeschief::CLI cli("name", "description");
+    for (const auto letter : std::string("abcdefghij")) {
+        cli.addOption("flag-" + std::string(1, letter) + "," + letter, "A flag");
+    }
+
+    return cli;
+}
+
+auto flagsArgv() -> std::vector<std::string> {
+    return {"name", "--flag-a", "--flag-b", "--flag-c", "--flag-d", "--flag-e", "-fghij"};
+}
+
+auto integersCLI() -> yeschief::CLI {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<int>>("numbers", "Numbers");
+    cli.parsePositional("numbers");
+
+    return cli;
+}
+
+auto integersArgv() -> std::vector<std::string> {
+    std::vector<std::string> strings = {"name"};
+    for (int i = 0; i < 1000; i++) {
+        strings.push_back(std::to_string(i * 1000));
+    }
+
+    return strings;
+}
+} // namespace
+
+TEST(Allocation, parseArgvWithFlags) {
+    const std::vector<std::string> allowed_options = {
+      "flag-a", "a", "flag-b", "b", "flag-c", "c", "flag-d", "d", "flag-e", "e",
+      "flag-f", "f", "flag-g", "g", "flag-h", "h", "flag-i", "i", "flag-j", "j",
+    };
+    const auto strings = flagsArgv();
+    auto argv          = toStringArray(strings);
+
+    const AllocationCounter counter;
+    const auto result = yeschief::parseArgv(static_cast<int>(argv.size()) - 1, argv.data() + 1, allowed_options);
+    const auto count  = counter.count();
+    ASSERT_TRUE(result);
+    ASSERT_LE(count, 50);
+}
+
+TEST(Allocation, runWithFlags) {
+    const auto cli     = flagsCLI();
+    const auto strings = flagsArgv();
+    auto argv          = toStringArray(strings);
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+    const auto count  = counter.count();
+    ASSERT_TRUE(result);
+    ASSERT_LE(count, 40);
+}
+
+TEST(Allocation, runWithPrefixMatchingAndExactNames) {
+    const auto cli     = flagsCLI();
+    auto prefixes_cli  = flagsCLI();
+    const auto strings = flagsArgv();
+    auto argv          = toStringArray(strings);
+    prefixes_cli.setPrefixMatching(true);
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+    const auto count  = counter.count();
+    const AllocationCounter prefixes_counter;
+    const auto prefixes_result = prefixes_cli.run(static_cast<int>(argv.size()), argv.data());
+    const auto prefixes_count  = prefixes_counter.count();
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(prefixes_result);
+    // The prefix index is not built when names are given in full
+    ASSERT_EQ(count, prefixes_count);
+}
+
+TEST(Allocation, runWithPositionalIntegers) {
+    const auto cli     = integersCLI();
+    const auto strings = integersArgv();
+    auto argv          = toStringArray(strings);
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+    const auto count  = counter.count();
+    ASSERT_TRUE(result);
+    // Does not grow with the count of values
+    ASSERT_LE(count, 20);
+}
+
+TEST(Allocation, runWithReusedContext) {
+    const auto cli     = integersCLI();
+    const auto strings = integersArgv();
+    auto argv          = toStringArray(strings);
+    yeschief::ParseContext context;
+    ASSERT_TRUE(cli.run(static_cast<int>(argv.size()), argv.data(), context));
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data(), context);
+    const auto count  = counter.count();
+    ASSERT_TRUE(result);
+    // Only the converted list and its std::any
+    ASSERT_LE(count, 2);
+}
+
+TEST(Allocation, runCommand) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    const std::vector<std::string> strings = {"name", "my-command", "--exit=3"};
+    auto argv                              = toStringArray(strings);
+
+    const AllocationCounter counter;
+    const auto result = cli.runCommand(static_cast<int>(argv.size()), argv.data());
+    const auto count  = counter.count();
+    ASSERT_TRUE(result);
+    ASSERT_LE(count, 8);
+}
+
+TEST(Allocation, failedRunWithReusedContext) {
+    const auto cli                         = integersCLI();
+    const std::vector<std::string> strings = {"name", "1", "2", "not-a-number", "4"};
+    auto argv                              = toStringArray(strings);
+    yeschief::ParseContext context;
+    ASSERT_FALSE(cli.run(static_cast<int>(argv.size()), argv.data(), context));
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data(), context);
+    const auto count  = counter.count();
+    ASSERT_FALSE(result);
+    // Only the list being converted, the Fault itself does not allocate
+    ASSERT_LE(count, 1);
+}
+
+TEST(Allocation, unrecognizedOptionWithReusedContext) {
+    const auto cli                         = flagsCLI();
+    const std::vector<std::string> strings = {"name", "--flag-z"};
+    auto argv                              = toStringArray(strings);
+    yeschief::ParseContext context;
+    ASSERT_FALSE(cli.run(static_cast<int>(argv.size()), argv.data(), context));
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data(), context);
+    const auto count  = counter.count();
+    ASSERT_FALSE(result);
+    // Close option names are only searched when asked for
+    ASSERT_EQ(0, count);
+    ASSERT_FALSE(result.error().suggestions().empty());
+}
+
+TEST(Allocation, renderHelpWithManyOptions) {
+    yeschief::CLI cli("name", "description");
+    for (int i = 0; i < 1000; i++) {
+        cli.addOption<int>(
+            "option-" + std::to_string(i), "Description of option\non several\nlines", {.value_help = "<n>"}
+        );
+    }
+    std::ostringstream out;
+
+    const AllocationCounter counter;
+    cli.help(out);
+    const auto count = counter.count();
+
+    ASSERT_FALSE(out.str().empty());
+    // Only the growth of the rendered message and of out
+    ASSERT_LE(count, 32) << "help rendering made " << count << " allocations";
+}
+
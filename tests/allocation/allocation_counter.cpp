@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "allocation_counter.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace {
+thread_local size_t allocation_count = 0;
+thread_local size_t allocated_bytes  = 0;
+// Signed as memory can be freed by another thread than the one allocating it
+thread_local int64_t live_bytes      = 0;
+thread_local int64_t peak_live_bytes = 0;
+
+auto track(void *pointer, const size_t size) -> void * {
+    if (pointer == nullptr) {
+        return nullptr;
+    }
+    allocation_count++;
+    allocated_bytes += size;
+    live_bytes += static_cast<int64_t>(malloc_usable_size(pointer));
+    peak_live_bytes = std::max(peak_live_bytes, live_bytes);
+
+    return pointer;
+}
+
+auto allocate(const size_t size) -> void * {
+    return track(std::malloc(size == 0 ? 1 : size), size);
+}
+
+auto allocate(const size_t size, const std::align_val_t alignment) -> void * {
+    const auto align = static_cast<size_t>(alignment);
+    return track(std::aligned_alloc(align, (size + align - 1) / align * align), size);
+}
+
+auto orBadAlloc(void *pointer) -> void * {
+    if (pointer == nullptr) {
+#if __cpp_exceptions
+        throw std::bad_alloc();
+#else
+        std::abort();
+#endif
+    }
+
+    return pointer;
+}
+
+auto deallocate(void *pointer) -> void {
+    if (pointer != nullptr) {
+        live_bytes -= static_cast<int64_t>(malloc_usable_size(pointer));
+        std::free(pointer);
+    }
+}
+} // namespace
+
+auto operator new(const size_t size) -> void * {
+    return orBadAlloc(allocate(size));
+}
+
+auto operator new[](const size_t size) -> void * {
+    return orBadAlloc(allocate(size));
+}
+
+auto operator new(const size_t size, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size);
+}
+
+auto operator new[](const size_t size, const std::nothrow_t &) noexcept -> void * {
+    return allocate(size);
+}
+
+auto operator new(const size_t size, const std::align_val_t alignment) -> void * {
+    return orBadAlloc(allocate(size, alignment));
+}
+
+auto operator new[](const size_t size, const std::align_val_t alignment) -> void * {
+    return orBadAlloc(allocate(size, alignment));
+}
+
+auto operator delete(void *pointer) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void *pointer) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void *pointer, size_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void *pointer, size_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void *pointer, std::align_val_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void *pointer, std::align_val_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete(void *pointer, size_t, std::align_val_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+auto operator delete[](void *pointer, size_t, std::align_val_t) noexcept -> void {
+    deallocate(pointer);
+}
+
+AllocationCounter::AllocationCounter()
+    : _start_count(allocation_count), _start_bytes(allocated_bytes), _start_live_bytes(live_bytes) {
+    peak_live_bytes = live_bytes;
+}
+
+auto AllocationCounter::count() const -> size_t {
+    return allocation_count - _start_count;
+}
+
+auto AllocationCounter::bytes() const -> size_t {
+    return allocated_bytes - _start_bytes;
+}
+
+auto AllocationCounter::peakBytes() const -> size_t {
+    return static_cast<size_t>(std::max<int64_t>(0, peak_live_bytes - _start_live_bytes));
+}
@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * Count heap allocations made by the current thread (through any global `operator new`) while it is alive, and the
+ * peak of heap memory it used. Only the last counter constructed on a thread tracks the peak
+ */
+class AllocationCounter final {
+  public:
+    AllocationCounter();
+
+    /**
+     * @return Count of allocations since construction
+     */
+    [[nodiscard]] auto count() const -> size_t;
+
+    /**
+     * @return Count of bytes allocated since construction
+     */
+    [[nodiscard]] auto bytes() const -> size_t;
+
+    /**
+     * @return Highest count of bytes in use at the same time since construction, not counting the ones already in use
+     * at construction
+     */
+    [[nodiscard]] auto peakBytes() const -> size_t;
+
+  private:
+    size_t _start_count;
+    size_t _start_bytes;
+    int64_t _start_live_bytes;
+};
+
+#endif // ALLOCATION_COUNTER_H
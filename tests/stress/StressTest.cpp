@@ -0,0 +1,150 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "../allocation/allocation_counter.hpp"
+#include "../unit/test_tools.hpp"
+
+#include <gtest/gtest.h>
+#include <string>
+#include <sys/resource.h>
+#include <vector>
+#include <yeschief.h>
+
+/*
+ * Parse argvs as large as the usual ARG_MAX of Linux (2 MiB) and bound the memory used to do it. Each test runs in its
+ * own process so peak RSS is the one of a single workload
+ */
+
+namespace {
+/**
+ * Usual ARG_MAX on Linux
+ */
+constexpr size_t ARGV_SIZE = 2 * 1024 * 1024;
+
+/**
+ * Peak RSS of the process cannot go above it
+ */
+constexpr long PEAK_RSS_CEILING_KB = 128 * 1024;
+
+/**
+ * Build an argv of ARGV_SIZE bytes (counting terminating '\0') repeating argument(i)
+ */
+auto maximalArgv(const std::function<std::string(size_t)> &argument) -> std::vector<std::string> {
+    std::vector<std::string> strings = {"name"};
+    size_t size                      = strings[0].size() + 1;
+    for (size_t i = 0; size < ARGV_SIZE; i++) {
+        strings.push_back(argument(i));
+        size += strings.back().size() + 1;
+    }
+
+    return strings;
+}
+
+auto inputBytes(const std::vector<std::string> &strings) -> size_t {
+    size_t size = 0;
+    for (const auto &string : strings) {
+        size += string.size() + 1;
+    }
+
+    return size;
+}
+
+/**
+ * Run cli on strings and check the heap memory used by the parsing is at most max_ratio times the size of argv
+ */
+auto runWithinMemoryBounds(const yeschief::CLI &cli, const std::vector<std::string> &strings, const double max_ratio)
+    -> void {
+    auto argv = toStringArray(strings);
+
+    const AllocationCounter counter;
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+    const auto peak   = counter.peakBytes();
+    ASSERT_TRUE(result);
+
+    const auto ratio = static_cast<double>(peak) / static_cast<double>(inputBytes(strings));
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    testing::Test::RecordProperty("input_bytes", std::to_string(inputBytes(strings)));
+    testing::Test::RecordProperty("peak_heap_bytes", std::to_string(peak));
+    testing::Test::RecordProperty("bytes_per_input_byte", std::to_string(ratio));
+    testing::Test::RecordProperty("peak_rss_kb", std::to_string(usage.ru_maxrss));
+    ASSERT_LE(ratio, max_ratio);
+    ASSERT_LE(usage.ru_maxrss, PEAK_RSS_CEILING_KB);
+}
+} // namespace
+
+TEST(Stress, positionalIntegers) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<int>>("numbers", "Numbers");
+    cli.parsePositional("numbers");
+
+    runWithinMemoryBounds(
+        cli,
+        maximalArgv([](const size_t i) {
+            return std::to_string(i % 1000000);
+        }),
+        8
+    );
+}
+
+TEST(Stress, repeatedStringOption) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<std::string>>("file,f", "Files");
+
+    runWithinMemoryBounds(
+        cli,
+        maximalArgv([](const size_t i) {
+            return (i % 2 == 0 ? "--file=src/module/file-" : "-f=tests/file-") + std::to_string(i) + ".cpp";
+        }),
+        8
+    );
+}
+
+TEST(Stress, flagBundles) {
+    yeschief::CLI cli("name", "description");
+    for (const auto letter : std::string("abcdefgh")) {
+        cli.addOption("flag-" + std::string(1, letter) + "," + letter, "A flag");
+    }
+
+    runWithinMemoryBounds(
+        cli,
+        maximalArgv([](const size_t i) {
+            return i % 2 == 0 ? "-abcd" : "-efgh";
+        }),
+        // Each flag of a bundle is a 1 byte option with a value
+        40
+    );
+}
+
+TEST(Stress, separatedValues) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "A number");
+
+    runWithinMemoryBounds(
+        cli,
+        maximalArgv([](const size_t i) {
+            return i % 2 == 0 ? "--number" : std::to_string(i);
+        }),
+        8
+    );
+}
@@ -21,9 +21,14 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <array>
+#include <memory_resource>
 #include <yeschief.h>
 
+using namespace ::testing;
+
 TEST(CLIResults, itReturnsNulloptWhenNoValue) {
     const auto results = yeschief::CLIResults({});
     ASSERT_EQ(std::nullopt, results.get("something"));
@@ -35,3 +40,66 @@ TEST(CLIResults, itReturnsTheValueSet) {
     ASSERT_EQ(34, std::any_cast<int>(results.get("something").value()));
     ASSERT_STREQ("bar", std::any_cast<std::string>(results.get("foo").value()).c_str());
 }
+
+TEST(CLIResults, itStoresValuesInMemoryResource) {
+    std::array<std::byte, 1024> buffer{};
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    const auto results = yeschief::CLIResults({std::make_pair("a-name-longer-than-small-strings", 34)}, &resource);
+    ASSERT_EQ(34, std::any_cast<int>(results.get("a-name-longer-than-small-strings").value()));
+}
+
+TEST(CLIResults, deserializeReadsSerializedValues) {
+    const auto results = yeschief::CLIResults({
+      std::make_pair("bool", true),
+      std::make_pair("string", std::string("a value longer than small strings")),
+      std::make_pair("int", -12),
+      std::make_pair("float", 1.5F),
+      std::make_pair("double", 3.14),
+      std::make_pair("bool-list", std::vector{true, false}),
+      std::make_pair("string-list", std::vector<std::string>{"a", ""}),
+      std::make_pair("int-list", std::vector{1, 2, 3}),
+      std::make_pair("float-list", std::vector<float>{}),
+      std::make_pair("double-list", std::vector{0.5, 0.25}),
+    });
+
+    const auto data         = results.serialize(42).value();
+    const auto deserialized = yeschief::CLIResults::deserialize(data, 42);
+    ASSERT_TRUE(deserialized);
+    ASSERT_TRUE(std::any_cast<bool>(deserialized->get("bool").value()));
+    ASSERT_EQ("a value longer than small strings", std::any_cast<std::string>(deserialized->get("string").value()));
+    ASSERT_EQ(-12, std::any_cast<int>(deserialized->get("int").value()));
+    ASSERT_EQ(1.5F, std::any_cast<float>(deserialized->get("float").value()));
+    ASSERT_EQ(3.14, std::any_cast<double>(deserialized->get("double").value()));
+    ASSERT_THAT(std::any_cast<std::vector<bool>>(deserialized->get("bool-list").value()), ElementsAre(true, false));
+    ASSERT_THAT(
+        std::any_cast<std::vector<std::string>>(deserialized->get("string-list").value()), ElementsAre("a", "")
+    );
+    ASSERT_THAT(std::any_cast<std::vector<int>>(deserialized->get("int-list").value()), ElementsAre(1, 2, 3));
+    ASSERT_THAT(std::any_cast<std::vector<float>>(deserialized->get("float-list").value()), IsEmpty());
+    ASSERT_THAT(std::any_cast<std::vector<double>>(deserialized->get("double-list").value()), ElementsAre(0.5, 0.25));
+    ASSERT_EQ(std::nullopt, deserialized->get("missing"));
+}
+
+TEST(CLIResults, serializeReturnsFaultWhenValueHasNotTheTypeOfAnOption) {
+    // The option of the Fault is a view on the name of the value, which must still be alive
+    const auto results = yeschief::CLIResults({std::make_pair("int", 12), std::make_pair("long", 12L)});
+    const auto data    = results.serialize(42);
+    ASSERT_FALSE(data);
+    ASSERT_EQ(yeschief::FaultType::UnserializableValue, data.error().type);
+    ASSERT_EQ("long", data.error().option);
+}
+
+TEST(CLIResults, deserializeReturnsFaultWhenFingerprintDiffers) {
+    const auto data         = yeschief::CLIResults({std::make_pair("int", 12)}).serialize(42).value();
+    const auto deserialized = yeschief::CLIResults::deserialize(data, 43);
+    ASSERT_FALSE(deserialized);
+    ASSERT_EQ(yeschief::FaultType::InvalidSerializedResults, deserialized.error().type);
+}
+
+TEST(CLIResults, deserializeReturnsFaultWhenDataIsTruncated) {
+    const auto data = yeschief::CLIResults({std::make_pair("list", std::vector{1, 2, 3})}).serialize(42).value();
+    for (size_t size = 0; size < data.size(); size++) {
+        ASSERT_FALSE(yeschief::CLIResults::deserialize(std::string_view(data).substr(0, size), 42));
+    }
+    ASSERT_FALSE(yeschief::CLIResults::deserialize(data + "trailing", 42));
+}
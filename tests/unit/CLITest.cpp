@@ -25,6 +25,9 @@
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <array>
+#include <cstdlib>
+#include <memory_resource>
 #include <yeschief.h>
 
 using namespace ::testing;
@@ -59,13 +62,10 @@ TEST(CLI, addOptionThrowIfAddExisting) {
     ASSERT_EXIT(cli.addOption("name", "My option"), KilledBySignal(SIGABRT), HasSubstr("CLI has already this option"));
 }
 
-TEST(CLI, addOptionThowIfInvalidType) {
-    yeschief::CLI cli("name", "description");
-    ASSERT_EXIT(
-        cli.addOption<yeschief::Fault>("name", "My option"),
-        KilledBySignal(SIGABRT),
-        HasSubstr("Type is not allowed for options")
-    );
+TEST(CLI, addOptionRejectsInvalidTypeAtCompileTime) {
+    // addOption<yeschief::Fault> does not compile, it checks the same
+    static_assert(! yeschief::optionTypeOf<yeschief::Fault>().has_value());
+    static_assert(yeschief::optionTypeOf<std::vector<double>>() == yeschief::OptionType::DoubleList);
 }
 
 TEST(CLI, addOptionWithType) {
@@ -272,6 +272,64 @@ Commands:
     );
 }
 
+TEST(CLI, helpWrapsDescriptions) {
+    yeschief::CLI cli("cli", "description");
+    cli.addOption("verbose", "Display more details about what is being done").setHelpWidth(30);
+    std::stringstream ss;
+    cli.help(ss);
+
+    ASSERT_THAT(ss.str(), HasSubstr("  --verbose\n    Display more details about\n    what is being done\n"));
+}
+
+TEST(CLI, helpWrapsCommandDescriptions) {
+    yeschief::CLI cli("cli", "description");
+    cli.setHelpWidth(24);
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    std::stringstream ss;
+    cli.help(ss);
+
+    ASSERT_THAT(ss.str(), HasSubstr("    Stub class for\n    Command.\n    Description on\n    another line.\n"));
+}
+
+TEST(CLI, helpIsNotWrappedWhenWrittenToAStream) {
+    const std::string description(200, 'a');
+    yeschief::CLI cli("cli", "description");
+    cli.addOption("verbose", description);
+    std::stringstream ss;
+    cli.help(ss);
+
+    ASSERT_THAT(ss.str(), HasSubstr("    " + description + "\n"));
+}
+
+TEST(CLI, helpIsRenderedAgainAfterChange) {
+    yeschief::CLI cli("cli", "description");
+    cli.addOption("verbose", "Verbose");
+    std::stringstream before;
+    cli.help(before);
+    cli.addOption<int>("number", "A number", {.required = true});
+    cli.parsePositional("number");
+    std::stringstream after;
+    cli.help(after);
+
+    ASSERT_THAT(before.str(), Not(HasSubstr("NUMBER")));
+    ASSERT_THAT(after.str(), HasSubstr("cli [OPTIONS] NUMBER"));
+    ASSERT_THAT(after.str(), HasSubstr("--number VALUE [REQUIRED]"));
+}
+
+TEST(CLI, helpIsSameOnACopy) {
+    yeschief::CLI cli("cli", "description");
+    cli.addOption("verbose", "Verbose");
+    std::stringstream original;
+    cli.help(original);
+    const auto copy = cli;
+    cli.addOption("quiet", "Quiet");
+    std::stringstream copied;
+    copy.help(copied);
+
+    ASSERT_EQ(original.str(), copied.str());
+}
+
 TEST(CLI, runReturnsFaultWhenArgc0) {
     const yeschief::CLI cli("name", "description");
     const auto result = cli.run(0, {});
@@ -390,6 +448,44 @@ TEST(CLI, runReturnsResultForOptionWithDefaultValue) {
     ASSERT_EQ(3.14, std::any_cast<double>(result.value().get("foo").value()));
 }
 
+TEST(CLI, runReturnsResultFromEnvironment) {
+    const EnvironmentVariable foo("YESCHIEF_TEST_FOO", "12");
+    const EnvironmentVariable bar("YESCHIEF_TEST_BAR", "from environment");
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "Foo", {.default_value = 1, .env = "YESCHIEF_TEST_FOO"})
+        .addOption<std::string>("bar", "Bar", {.env = "YESCHIEF_TEST_BAR"})
+        .addOption<int>("baz", "Baz", {.default_value = 3, .env = "YESCHIEF_TEST_BAZ"});
+
+    // Argv takes precedence over the environment, which takes precedence over defaults
+    const auto result = cli.run(3, toStringArray({"name", "--bar", "from argv"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, std::any_cast<int>(result->get("foo").value()));
+    ASSERT_EQ("from argv", std::any_cast<std::string>(result->get("bar").value()));
+    ASSERT_EQ(3, std::any_cast<int>(result->get("baz").value()));
+}
+
+TEST(CLI, runReturnsFaultWhenEnvironmentValueHasBadType) {
+    const EnvironmentVariable foo("YESCHIEF_TEST_FOO", "twelve");
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "Foo", {.env = "YESCHIEF_TEST_FOO"});
+
+    const auto result = cli.run(1, toStringArray({"name"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidOptionType, result.error().type);
+    ASSERT_EQ("foo", result.error().option);
+    ASSERT_EQ(std::nullopt, result.error().argument_index);
+}
+
+TEST(CLI, runSetsRequiredOptionFromEnvironment) {
+    const EnvironmentVariable foo("YESCHIEF_TEST_FOO", "a");
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<std::string>>("foo", "Foo", {.required = true, .env = "YESCHIEF_TEST_FOO"});
+
+    const auto result = cli.run(1, toStringArray({"name"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_THAT(std::any_cast<std::vector<std::string>>(result->get("foo").value()), ElementsAre("a"));
+}
+
 TEST(CLI, runReturnsFaultIfOptionGivenWithoutValue) {
     yeschief::CLI cli("name", "description");
     cli.addOption<int>("foo", "bar");
@@ -445,3 +541,368 @@ TEST(CLI, runReturnsResultWhenCommandWithArgs) {
     cli.addCommand(&command);
     ASSERT_EXIT(cli.run(3, toStringArray({"name", "my-command", "--exit=12"}).data()), ExitedWithCode(12), ".*");
 }
+
+TEST(CLI, runWithMemoryResource) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?").addOption<std::string>("a-long-option-name", "Foo?");
+    cli.parsePositional("a-long-option-name");
+    std::array<std::byte, 4096> buffer{};
+    std::pmr::monotonic_buffer_resource resource(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+    const auto result = cli.run(
+        4, toStringArray({"name", "--foo", "12", "a positional value longer than small strings"}).data(), &resource
+    );
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, std::any_cast<int>(result->get("foo").value()));
+    ASSERT_STREQ(
+        "a positional value longer than small strings",
+        std::any_cast<std::string>(result->get("a-long-option-name").value()).c_str()
+    );
+}
+
+TEST(CLI, runCommandReturnsExitCode) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    const auto result = cli.runCommand(3, toStringArray({"name", "my-command", "--exit=12"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, result.value());
+}
+
+TEST(CLI, runCommandReturnsNulloptWhenNoCommand) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    const auto result = cli.runCommand(1, toStringArray({"name"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(std::nullopt, result.value());
+}
+
+TEST(CLI, runCommandReturnsFaultWhenCommandDoNotExists) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    const auto result = cli.runCommand(2, toStringArray({"name", "help"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnknownCommand, result.error().type);
+}
+
+TEST(CLI, runMatchesOptionPrefixes) {
+    yeschief::CLI cli("name", "description");
+    cli.setPrefixMatching(true);
+    cli.addOption("verbose", "Verbose").addOption<int>("version", "Version").addOption("ver", "Ver");
+
+    const auto result = cli.run(4, toStringArray({"name", "--verb", "--versi=3", "--ver"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(std::any_cast<bool>(result->get("verbose").value()));
+    ASSERT_EQ(3, std::any_cast<int>(result->get("version").value()));
+    ASSERT_TRUE(std::any_cast<bool>(result->get("ver").value()));
+}
+
+TEST(CLI, runReturnsFaultWhenOptionPrefixIsAmbiguous) {
+    yeschief::CLI cli("name", "description");
+    cli.setPrefixMatching(true);
+    cli.addOption("verbose", "Verbose").addOption<int>("version", "Version");
+
+    // The token of the Fault is a view on argv, which must still be alive
+    const std::vector<std::string> args = {"name", "--ve"};
+    const auto result                   = cli.run(2, toStringArray(args).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::AmbiguousPrefix, result.error().type);
+    ASSERT_EQ("ve", result.error().token);
+    ASSERT_EQ(1, result.error().argument_index);
+    ASSERT_THAT(result.error().candidates, ElementsAre("verbose", "version"));
+}
+
+TEST(CLI, runDoesNotMatchPrefixesByDefault) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("verbose", "Verbose");
+
+    const auto result = cli.run(2, toStringArray({"name", "--verb"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+}
+
+TEST(CLI, runCommandMatchesCommandPrefixes) {
+    yeschief::CLI cli("name", "description");
+    CommandStub status("status");
+    CommandStub stash("stash");
+    cli.setPrefixMatching(true);
+    cli.addCommand(&status).addCommand(&stash);
+
+    const auto result = cli.runCommand(3, toStringArray({"name", "stat", "--ex=12"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, result.value());
+
+    const std::vector<std::string> args = {"name", "st"};
+    const auto fault                    = cli.runCommand(2, toStringArray(args).data());
+    ASSERT_FALSE(fault);
+    ASSERT_EQ(yeschief::FaultType::AmbiguousPrefix, fault.error().type);
+    ASSERT_EQ("st", fault.error().token);
+    ASSERT_EQ(1, fault.error().argument_index);
+    ASSERT_THAT(fault.error().candidates, ElementsAre("stash", "status"));
+}
+
+TEST(CLI, runSuggestsCloseOptions) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("verbose", "Verbose").addOption<int>("version", "Version");
+
+    // Suggestions are searched from the token, argv must still be alive
+    const std::vector<std::string> args = {"name", "--verbos"};
+    const auto result                   = cli.run(2, toStringArray(args).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_THAT(result.error().suggestions(), ElementsAre("verbose"));
+}
+
+TEST(CLI, runCommandSuggestsCloseCommands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub status("status");
+    CommandStub stash("stash");
+    cli.addCommand(&status).addCommand(&stash);
+
+    const std::vector<std::string> args = {"name", "stats"};
+    const auto result                   = cli.runCommand(2, toStringArray(args).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnknownCommand, result.error().type);
+    ASSERT_THAT(result.error().suggestions(), ElementsAre("status"));
+}
+
+TEST(CLI, runCommandThrowIfOptions) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("name", "My option");
+    ASSERT_EXIT(
+        cli.runCommand(1, toStringArray({"name"}).data()),
+        KilledBySignal(SIGABRT),
+        HasSubstr("Cannot run a command of a cli using options")
+    );
+}
+
+TEST(CLI, runBatchReturnsResultsInOrder) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?", {.required = true});
+    std::vector<std::vector<std::string>> argvs;
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 3) {
+            argvs.push_back({"name", "--foo=not-a-number"});
+        } else {
+            argvs.push_back({"name", "-f", std::to_string(i)});
+        }
+    }
+
+    const auto results = cli.runBatch(argvs, 4);
+    ASSERT_EQ(argvs.size(), results.size());
+    for (int i = 0; i < 1000; i++) {
+        if (i % 10 == 3) {
+            ASSERT_FALSE(results[i]);
+            ASSERT_EQ(yeschief::FaultType::InvalidOptionType, results[i].error().type);
+        } else {
+            ASSERT_TRUE(results[i]);
+            ASSERT_EQ(i, std::any_cast<int>(results[i]->get("foo").value()));
+        }
+    }
+}
+
+TEST(CLI, runBatchWithEmptyArgvs) {
+    const yeschief::CLI cli("name", "description");
+    ASSERT_THAT(cli.runBatch({}), IsEmpty());
+}
+
+TEST(CLI, runBatchThrowIfCommands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    ASSERT_EXIT(cli.runBatch({}), KilledBySignal(SIGABRT), HasSubstr("Cannot run a batch on a cli using commands"));
+}
+
+TEST(CLI, runConvertsLargeListInParallel) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<int>>("numbers", "Numbers");
+    cli.parsePositional("numbers");
+    cli.setParallelConversionThreshold(1000);
+    std::vector<std::string> strings = {"name"};
+    for (int i = 0; i < 100000; i++) {
+        strings.push_back(std::to_string(i));
+    }
+    auto argv = toStringArray(strings);
+
+    const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+    ASSERT_TRUE(result);
+    const auto numbers = std::any_cast<std::vector<int>>(result->get("numbers").value());
+    ASSERT_EQ(100000, numbers.size());
+    for (int i = 0; i < 100000; i++) {
+        ASSERT_EQ(i, numbers[i]);
+    }
+}
+
+TEST(CLI, runConvertsLargeListInParallelReturnsFirstFault) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<double>>("numbers", "Numbers");
+    cli.parsePositional("numbers");
+    cli.setParallelConversionThreshold(1000);
+    std::vector<std::string> strings = {"name"};
+    for (int i = 0; i < 100000; i++) {
+        strings.push_back(std::to_string(i));
+    }
+    strings[90001] = "last";
+    strings[20001] = "first";
+    auto argv = toStringArray(strings);
+
+    for (int i = 0; i < 10; i++) {
+        const auto result = cli.run(static_cast<int>(argv.size()), argv.data());
+        ASSERT_FALSE(result);
+        ASSERT_EQ(yeschief::FaultType::InvalidOptionType, result.error().type);
+        ASSERT_EQ("first", result.error().token);
+        ASSERT_EQ(20001, result.error().argument_index);
+    }
+}
+
+TEST(CLI, runBatchConvertsLargeListSerially) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<int>>("numbers", "Numbers");
+    cli.parsePositional("numbers");
+    cli.setParallelConversionThreshold(1000);
+    std::vector<std::string> strings = {"name"};
+    for (int i = 0; i < 100000; i++) {
+        strings.push_back(std::to_string(i));
+    }
+    const std::vector<std::vector<std::string>> argvs(8, strings);
+
+    const auto results = cli.runBatch(argvs, 4);
+    ASSERT_EQ(argvs.size(), results.size());
+    for (const auto &result : results) {
+        ASSERT_TRUE(result);
+        const auto numbers = std::any_cast<std::vector<int>>(result->get("numbers").value());
+        ASSERT_EQ(100000, numbers.size());
+        ASSERT_EQ(99999, numbers.back());
+    }
+}
+
+TEST(CLI, runFaultLocatesArgument) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("verbose,v", "Verbose").addOption<int>("number,n", "Number");
+
+    const std::vector<std::string> unrecognized = {"name", "-v", "--number=3", "-vx"};
+    const auto unrecognized_result = cli.run(4, toStringArray(unrecognized).data());
+    ASSERT_FALSE(unrecognized_result);
+    ASSERT_EQ("x", unrecognized_result.error().token);
+    ASSERT_EQ(3, unrecognized_result.error().argument_index);
+
+    const std::vector<std::string> invalid = {"name", "-v", "--number=three"};
+    const auto invalid_result              = cli.run(3, toStringArray(invalid).data());
+    ASSERT_FALSE(invalid_result);
+    ASSERT_EQ("number", invalid_result.error().option);
+    ASSERT_EQ("three", invalid_result.error().token);
+    ASSERT_EQ("int", invalid_result.error().expected_type);
+    ASSERT_EQ(2, invalid_result.error().argument_index);
+    ASSERT_EQ("'three' cannot be parsed to an int value", invalid_result.error().message());
+}
+
+TEST(CLI, runCommandFaultLocatesArgument) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    const std::vector<std::string> strings = {"name", "my-command", "--exit", "three"};
+    const auto result                      = cli.runCommand(4, toStringArray(strings).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ("exit", result.error().option);
+    ASSERT_EQ(3, result.error().argument_index);
+}
+
+TEST(CLI, runCollectingFaults) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "Number")
+        .addOption<std::string>("label", "Label")
+        .addOption<std::string>("path", "Path", {.required = true})
+        .addOption<std::string>("mode", "Mode", {.required = true});
+
+    const std::vector<std::string> strings = {"name", "--number=three", "--unknown", "-x", "--label"};
+    const auto result = cli.runCollectingFaults(static_cast<int>(strings.size()), toStringArray(strings).data());
+    ASSERT_FALSE(result);
+    const auto &faults = result.error();
+    ASSERT_THAT(faults, SizeIs(6));
+    ASSERT_EQ(yeschief::FaultType::InvalidOptionType, faults[0].type);
+    ASSERT_EQ(1, faults[0].argument_index);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, faults[1].type);
+    ASSERT_EQ(2, faults[1].argument_index);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, faults[2].type);
+    ASSERT_EQ(3, faults[2].argument_index);
+    ASSERT_EQ(yeschief::FaultType::MissingOptionValue, faults[3].type);
+    ASSERT_EQ("label", faults[3].option);
+    ASSERT_EQ(yeschief::FaultType::MissingRequiredOption, faults[4].type);
+    ASSERT_EQ("mode", faults[4].option);
+    ASSERT_EQ(yeschief::FaultType::MissingRequiredOption, faults[5].type);
+    ASSERT_EQ("path", faults[5].option);
+}
+
+TEST(CLI, runCollectingFaultsReportsPositionalOnce) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("verbose,v", "Verbose");
+
+    const std::vector<std::string> strings = {"name", "value", "-v", "--verbose"};
+    const auto result = cli.runCollectingFaults(static_cast<int>(strings.size()), toStringArray(strings).data());
+    ASSERT_FALSE(result);
+    ASSERT_THAT(result.error(), SizeIs(1));
+    ASSERT_EQ("value", result.error()[0].token);
+    ASSERT_EQ(1, result.error()[0].argument_index);
+}
+
+TEST(CLI, runCollectingFaultsReturnsResults) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "Number");
+
+    const auto result = cli.runCollectingFaults(3, toStringArray({"name", "-n", "3"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(3, std::any_cast<int>(result->get("number").value()));
+}
+
+TEST(CLI, fingerprintDependsOnWhatResultsAreMadeOf) {
+    const auto configure = [](yeschief::CLI &cli, const std::string &description, const bool int_file) {
+        cli.addOption("verbose,v", description);
+        if (int_file) {
+            cli.addOption<int>("file", "File");
+        } else {
+            cli.addOption<std::string>("file", "File");
+        }
+        cli.parsePositional("file");
+    };
+    yeschief::CLI cli("name", "description");
+    configure(cli, "description", false);
+    yeschief::CLI described_cli("name", "another description");
+    configure(described_cli, "another description", false);
+    yeschief::CLI typed_cli("name", "description");
+    configure(typed_cli, "description", true);
+
+    ASSERT_EQ(cli.fingerprint(), described_cli.fingerprint());
+    ASSERT_NE(cli.fingerprint(), typed_cli.fingerprint());
+
+    const auto fingerprint = cli.fingerprint();
+    cli.addOption("quiet", "Quiet");
+    ASSERT_NE(fingerprint, cli.fingerprint());
+}
+
+TEST(CLI, fingerprintDependsOnCommands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    const auto fingerprint = cli.fingerprint();
+
+    yeschief::CLI other_cli("name", "description");
+    CommandStub other_command("other-command");
+    other_cli.addCommand(&other_command);
+    ASSERT_NE(fingerprint, other_cli.fingerprint());
+}
+
+TEST(CLI, runResultsSurviveSerialization) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::vector<int>>("numbers", "Numbers")
+        .addOption<std::string>("name", "Name", {.default_value = std::string("x")});
+
+    const auto results = cli.run(5, toStringArray({"name", "--numbers", "1", "--numbers", "2"}).data());
+    ASSERT_TRUE(results);
+    const auto data         = results->serialize(cli.fingerprint()).value();
+    const auto deserialized = yeschief::CLIResults::deserialize(data, cli.fingerprint());
+    ASSERT_TRUE(deserialized);
+    ASSERT_THAT(std::any_cast<std::vector<int>>(deserialized->get("numbers").value()), ElementsAre(1, 2));
+    ASSERT_EQ("x", std::any_cast<std::string>(deserialized->get("name").value()));
+}
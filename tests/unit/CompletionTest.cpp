@@ -0,0 +1,311 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+namespace {
+auto optionsCLI() -> yeschief::CLI {
+    yeschief::CLI cli("my-tool", "description");
+    cli.addOption("verbose,v", "Verbose output\nOn several lines")
+        .addOption<std::string>("output,o", "Output file")
+        .addOption<int>("count", "How many [times]", {.value_help = "N"})
+        .addOption<std::vector<std::string>>("inputs", "Input files", {.required = true});
+    cli.parsePositional("inputs");
+
+    return cli;
+}
+
+auto valuesCLI() -> yeschief::CLI {
+    const auto colors = [](std::string_view) -> std::vector<std::string> {
+        return {"red", "green", "blue"};
+    };
+    yeschief::CLI cli("my-tool", "description");
+    cli.addOption<std::string>("color,c", "Color", {.completion = colors})
+        .addOption<std::string>("name", "Name", {.completion = colors});
+    cli.parsePositional("name");
+
+    return cli;
+}
+
+/**
+ * my-tool remote branch my-command
+ */
+auto nestedCommandsCLI() -> yeschief::CLI {
+    static CommandStub command("my-command");
+    static ParentCommand branch("branch", &command);
+    static ParentCommand remote("remote", &branch);
+    yeschief::CLI cli("my-tool", "description");
+    cli.addCommand(&remote);
+
+    return cli;
+}
+
+auto commandsCLI() -> yeschief::CLI {
+    static CommandStub command("my-command");
+    yeschief::CLI cli("my-tool", "description");
+    cli.addCommand(&command);
+
+    return cli;
+}
+} // namespace
+
+TEST(Completion, bashCompletesOptionNames) {
+    const auto script = optionsCLI().completionScript(yeschief::Shell::Bash);
+
+    ASSERT_THAT(script, HasSubstr("_yeschief_my_tool() {\n"));
+    ASSERT_THAT(script, HasSubstr("compgen -W \"--verbose -v --output -o --count --inputs\" -- \"$cur\""));
+    ASSERT_THAT(script, HasSubstr("complete -F _yeschief_my_tool my-tool\n"));
+}
+
+TEST(Completion, bashCompletesValuesByType) {
+    const auto script = optionsCLI().completionScript(yeschief::Shell::Bash);
+
+    ASSERT_THAT(script, Not(HasSubstr("--verbose|-v)")));
+    ASSERT_THAT(script, HasSubstr("        --output|-o)\n            COMPREPLY=($(compgen -f -- \"$cur\"))\n"));
+    ASSERT_THAT(script, HasSubstr("        --count)\n            COMPREPLY=()\n            return\n"));
+    ASSERT_THAT(script, HasSubstr("    fi\n    COMPREPLY=($(compgen -f -- \"$cur\"))\n}"));
+}
+
+TEST(Completion, bashCompletesCommands) {
+    const auto script = commandsCLI().completionScript(yeschief::Shell::Bash);
+
+    ASSERT_THAT(script, HasSubstr("            my-command)\n                command=\"$word\""));
+    ASSERT_THAT(script, HasSubstr("COMPREPLY=($(compgen -W \"my-command\" -- \"$cur\"))"));
+    ASSERT_THAT(script, HasSubstr("        my-command)\n            case \"$prev\" in\n                --exit)\n"));
+}
+
+TEST(Completion, zshDescribesOptions) {
+    const auto script = optionsCLI().completionScript(yeschief::Shell::Zsh);
+
+    ASSERT_THAT(script, StartsWith("#compdef my-tool\n"));
+    ASSERT_THAT(script, HasSubstr("'(--verbose -v)'{--verbose,-v}'[Verbose output]' \\\n"));
+    ASSERT_THAT(script, HasSubstr("'(--output -o)'{--output,-o}'[Output file]:VALUE:_files' \\\n"));
+    ASSERT_THAT(script, HasSubstr("'--count[How many \\[times\\]]:N: ' \\\n"));
+    ASSERT_THAT(script, HasSubstr("'*--inputs[Input files]:VALUE:_files' \\\n"));
+    ASSERT_THAT(script, HasSubstr("'*:INPUTS:_files'\n"));
+    ASSERT_THAT(script, HasSubstr("compdef _my-tool my-tool\n"));
+}
+
+TEST(Completion, zshDescribesCommands) {
+    const auto script = commandsCLI().completionScript(yeschief::Shell::Zsh);
+
+    ASSERT_THAT(script, HasSubstr("'my-command:Stub class for Command.'\n"));
+    ASSERT_THAT(script, HasSubstr("my-command)\n                    _arguments -s \\\n"));
+}
+
+TEST(Completion, fishCompletesOptions) {
+    const auto script = optionsCLI().completionScript(yeschief::Shell::Fish);
+
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -l verbose -s v -d 'Verbose output'\n"));
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -l output -s o -r -F -d 'Output file'\n"));
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -l count -x -d 'How many [times]'\n"));
+    // Files are completed for positional inputs
+    ASSERT_THAT(script, Not(HasSubstr("complete -c my-tool -f\n")));
+}
+
+TEST(Completion, fishCompletesCommands) {
+    const auto script = commandsCLI().completionScript(yeschief::Shell::Fish);
+
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -f\n"));
+    ASSERT_THAT(
+        script,
+        HasSubstr("complete -c my-tool -n '__fish_use_subcommand' -a 'my-command' -d 'Stub class for Command.'\n")
+    );
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -n '__fish_seen_subcommand_from my-command' -l exit -x"));
+}
+
+TEST(Completion, bashCompletesNestedCommands) {
+    const auto script = nestedCommandsCLI().completionScript(yeschief::Shell::Bash);
+
+    ASSERT_THAT(script, HasSubstr("        \"\")\n            COMPREPLY=($(compgen -W \"remote\" -- \"$cur\"))\n"));
+    ASSERT_THAT(
+        script,
+        HasSubstr("        remote)\n            command=\"\"\n            while [[ $i -lt $COMP_CWORD ]]; do\n")
+    );
+    ASSERT_THAT(script, HasSubstr("COMPREPLY=($(compgen -W \"branch\" -- \"$cur\"))\n"));
+    ASSERT_THAT(script, HasSubstr("COMPREPLY=($(compgen -W \"my-command\" -- \"$cur\"))\n"));
+    ASSERT_THAT(script, HasSubstr("my-command)\n" + std::string(28, ' ') + "case \"$prev\" in\n"));
+}
+
+TEST(Completion, zshDescribesNestedCommands) {
+    const auto script = nestedCommandsCLI().completionScript(yeschief::Shell::Zsh);
+
+    ASSERT_THAT(script, HasSubstr("remote)\n                    _arguments -C '1: :->command' '*:: :->argument'\n"));
+    ASSERT_THAT(script, HasSubstr("'branch:Parent'"));
+    ASSERT_THAT(script, HasSubstr("'my-command:Stub class for Command.'\n"));
+    ASSERT_THAT(script, HasSubstr("my-command)\n" + std::string(52, ' ') + "_arguments -s \\\n"));
+}
+
+TEST(Completion, fishCompletesNestedCommands) {
+    const auto script = nestedCommandsCLI().completionScript(yeschief::Shell::Fish);
+
+    ASSERT_THAT(script, HasSubstr("complete -c my-tool -n '__fish_use_subcommand' -a 'remote'"));
+    ASSERT_THAT(
+        script,
+        HasSubstr(
+            "complete -c my-tool -n '__fish_seen_subcommand_from remote; and not __fish_seen_subcommand_from branch'"
+            " -a 'branch'"
+        )
+    );
+    ASSERT_THAT(
+        script,
+        HasSubstr(
+            "complete -c my-tool -n '__fish_seen_subcommand_from remote; and __fish_seen_subcommand_from branch; and "
+            "__fish_seen_subcommand_from my-command' -l exit -x"
+        )
+    );
+}
+
+TEST(Completion, quotesDescriptions) {
+    yeschief::CLI cli("my-tool", "description");
+    cli.addOption("force", "Don't ask");
+
+    ASSERT_THAT(cli.completionScript(yeschief::Shell::Fish), HasSubstr("-d 'Don'\\''t ask'"));
+    ASSERT_THAT(cli.completionScript(yeschief::Shell::Zsh), HasSubstr("'--force[Don'\\''t ask]'"));
+}
+
+TEST(Completion, completeOptionNames) {
+    const auto cli = optionsCLI();
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--o"}), ElementsAre("--output"));
+    ASSERT_THAT(
+        cli.complete(std::vector<std::string>{"--"}), ElementsAre("--count", "--inputs", "--output", "--verbose")
+    );
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"-"}), Contains("-v"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"-o"}), ElementsAre("-o"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"-v", "--c"}), ElementsAre("--count"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--x"}), IsEmpty());
+}
+
+TEST(Completion, completeCommands) {
+    const auto cli = commandsCLI();
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"my"}), ElementsAre("my-command"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"other"}), IsEmpty());
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"my-command", "--e"}), ElementsAre("--exit"));
+}
+
+TEST(Completion, completeNestedCommands) {
+    const auto cli = nestedCommandsCLI();
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"remote", "b"}), ElementsAre("branch"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"remote", "branch", ""}), ElementsAre("my-command"));
+    ASSERT_THAT(
+        cli.complete(std::vector<std::string>{"remote", "branch", "my-command", "--e"}), ElementsAre("--exit")
+    );
+}
+
+TEST(Completion, completeAfterCommandPrefixes) {
+    auto cli = nestedCommandsCLI();
+    cli.setPrefixMatching(true);
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"rem", "b"}), ElementsAre("branch"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"rem", "br", "my", "--e"}), ElementsAre("--exit"));
+    // Prefixes are not looked up unless enabled
+    ASSERT_THAT(nestedCommandsCLI().complete(std::vector<std::string>{"rem", "b"}), IsEmpty());
+}
+
+TEST(Completion, completeValues) {
+    const auto cli = valuesCLI();
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--color", "g"}), ElementsAre("green"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"-c", ""}), ElementsAre("red", "green", "blue"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--color=b"}), ElementsAre("--color=blue"));
+    // Positional argument
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--color", "red", "r"}), ElementsAre("red"));
+    // Nothing after a rejected word
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--unknown", ""}), IsEmpty());
+}
+
+TEST(Completion, completeValuesAfterOptionPrefixes) {
+    auto cli = valuesCLI();
+    cli.setPrefixMatching(true);
+
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--col=b"}), ElementsAre("--col=blue"));
+    ASSERT_THAT(cli.complete(std::vector<std::string>{"--col", "g"}), ElementsAre("green"));
+    // Prefixes are not looked up unless enabled
+    ASSERT_THAT(valuesCLI().complete(std::vector<std::string>{"--col=b"}), IsEmpty());
+}
+
+TEST(Completion, runCommandPrintsCandidates) {
+    const auto cli                      = commandsCLI();
+    const std::vector<std::string> args = {"my-tool", "__complete", "my-command", "--"};
+    auto argv                           = toStringArray(args);
+
+    internal::CaptureStdout();
+    const auto result = cli.runCommand(static_cast<int>(argv.size()), argv.data());
+    ASSERT_EQ("--exit\n", internal::GetCapturedStdout());
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ(0, result.value());
+}
+
+TEST(Completion, runWithContextTakesSwitchAsArgument) {
+    const auto cli                      = valuesCLI();
+    const std::vector<std::string> args = {"my-tool", "__complete"};
+    auto argv                           = toStringArray(args);
+    yeschief::ParseContext context;
+
+    internal::CaptureStdout();
+    const auto results = cli.run(static_cast<int>(argv.size()), argv.data(), context);
+    ASSERT_EQ("", internal::GetCapturedStdout());
+    ASSERT_TRUE(results.has_value());
+    ASSERT_EQ("__complete", std::any_cast<std::string>(results->get().get("name").value()));
+}
+
+TEST(Completion, runBatchTakesSwitchAsArgument) {
+    const auto cli = valuesCLI();
+
+    internal::CaptureStdout();
+    const auto results = cli.runBatch(std::vector<std::vector<std::string>>{{"my-tool", "__complete"}});
+    ASSERT_EQ("", internal::GetCapturedStdout());
+    ASSERT_THAT(results, SizeIs(1));
+    ASSERT_TRUE(results.front().has_value());
+    ASSERT_EQ("__complete", std::any_cast<std::string>(results.front()->get("name").value()));
+}
+
+TEST(Completion, scriptsCallProgramForValues) {
+    const auto cli = valuesCLI();
+
+    ASSERT_THAT(
+        cli.completionScript(yeschief::Shell::Bash),
+        HasSubstr(
+            "--color|-c)\n"
+            "            mapfile -t COMPREPLY < <(\"$1\" __complete \"${COMP_WORDS[@]:1:COMP_CWORD}\""
+        )
+    );
+    ASSERT_THAT(
+        cli.completionScript(yeschief::Shell::Zsh),
+        HasSubstr(":NAME:{local -a values=(${(f)\"$(my-tool __complete \"${(@)words[2,CURRENT]}\" 2>/dev/null)\"});")
+    );
+    ASSERT_THAT(
+        cli.completionScript(yeschief::Shell::Fish),
+        HasSubstr("-l color -s c -x -a '(my-tool __complete (commandline -opc)[2..-1] (commandline -ct))'")
+    );
+    ASSERT_THAT(cli.completionScript(yeschief::Shell::Fish), HasSubstr("complete -c my-tool -f\n"));
+}
@@ -0,0 +1,169 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+namespace {
+constexpr int THREAD_COUNT = 8;
+constexpr int ITERATIONS   = 500;
+} // namespace
+
+TEST(Concurrency, runOnSharedCLI) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "A number", {.required = true})
+        .addOption<std::vector<double>>("values", "Some values")
+        .addOption<std::string>("label,l", "A label", {.default_value = std::string("none")})
+        .addOption("verbose,v", "Verbose");
+    cli.parsePositional("number", "values");
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(THREAD_COUNT, 0);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&cli, &failures, t] {
+            yeschief::ParseContext context;
+            for (int i = 0; i < ITERATIONS; i++) {
+                const auto number = t * ITERATIONS + i;
+                const auto label  = "label-of-thread-" + std::to_string(t);
+                const std::vector<std::string> strings
+                    = {"name", "-v", "--label", label, "--", std::to_string(number), "1.5", "2.5"};
+                auto arguments   = toStringArray(strings);
+                const auto check = [&](const yeschief::CLIResults &results) {
+                    return std::any_cast<int>(results.get("number").value()) == number
+                        && std::any_cast<std::string>(results.get("label").value()) == label
+                        && std::any_cast<std::vector<double>>(results.get("values").value()).size() == 2;
+                };
+
+                if (i % 2 == 0) {
+                    const auto result = cli.run(static_cast<int>(arguments.size()), arguments.data());
+                    failures[t] += result.has_value() && check(result.value()) ? 0 : 1;
+                } else {
+                    const auto result = cli.run(static_cast<int>(arguments.size()), arguments.data(), context);
+                    failures[t] += result.has_value() && check(result.value()) ? 0 : 1;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        ASSERT_EQ(0, failures[t]) << "Thread " << t;
+    }
+}
+
+TEST(Concurrency, runWithPrefixesOnSharedCLI) {
+    yeschief::CLI cli("name", "description");
+    cli.setPrefixMatching(true);
+    cli.addOption<int>("number", "A number").addOption("verbose", "Verbose");
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(THREAD_COUNT, 0);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&cli, &failures, t] {
+            yeschief::ParseContext context;
+            for (int i = 0; i < ITERATIONS; i++) {
+                // The index of prefixes is built by the first of them
+                const std::vector<std::string> strings = {"name", "--verb", "--num=" + std::to_string(i)};
+                auto arguments                         = toStringArray(strings);
+                const auto result = cli.run(static_cast<int>(arguments.size()), arguments.data(), context);
+                if (! result.has_value() || std::any_cast<int>(result->get().get("number").value()) != i) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        ASSERT_EQ(0, failures[t]) << "Thread " << t;
+    }
+}
+
+TEST(Concurrency, runCommandOnSharedCLI) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(THREAD_COUNT, 0);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&cli, &failures, t] {
+            yeschief::ParseContext context;
+            for (int i = 0; i < ITERATIONS; i++) {
+                const auto exit_code                   = (t + i) % 256;
+                const std::vector<std::string> strings = {"name", "my-command", "--exit=" + std::to_string(exit_code)};
+                auto arguments                         = toStringArray(strings);
+                const auto result = cli.runCommand(static_cast<int>(arguments.size()), arguments.data(), context);
+                if (! result.has_value() || result.value() != exit_code) {
+                    failures[t]++;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        ASSERT_EQ(0, failures[t]) << "Thread " << t;
+    }
+}
+
+TEST(Concurrency, helpOnSharedCLI) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number,n", "A number", {.required = true}).addOption("verbose,v", "Verbose\nOn two lines");
+    cli.parsePositional("number");
+    // Rendered by a copy, so that threads race on the first rendering of cli
+    const auto reference = cli;
+    std::stringstream expected;
+    reference.help(expected);
+
+    std::vector<std::thread> threads;
+    std::vector<int> failures(THREAD_COUNT, 0);
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        threads.emplace_back([&cli, &expected, &failures, t] {
+            for (int i = 0; i < ITERATIONS; i++) {
+                std::stringstream out;
+                cli.help(out);
+                failures[t] += out.str() == expected.str() ? 0 : 1;
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    for (int t = 0; t < THREAD_COUNT; t++) {
+        ASSERT_EQ(0, failures[t]) << "Thread " << t;
+    }
+}
@@ -0,0 +1,237 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+namespace {
+/**
+ * Write content to a new temporary file, removed when it goes out of scope
+ */
+class TemporaryFile final {
+  public:
+    explicit TemporaryFile(const std::string &content)
+        : _path(TempDir() + "yeschief-" + UnitTest::GetInstance()->current_test_info()->name()) {
+        std::ofstream(_path) << content;
+    }
+
+    TemporaryFile(const TemporaryFile &)                    = delete;
+    auto operator=(const TemporaryFile &) -> TemporaryFile & = delete;
+
+    ~TemporaryFile() {
+        std::remove(_path.c_str());
+    }
+
+    [[nodiscard]] auto path() const -> const std::string & {
+        return _path;
+    }
+
+  private:
+    std::string _path;
+};
+} // namespace
+
+TEST(ConfigFile, openMapsContent) {
+    const TemporaryFile file("verbose\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    ASSERT_EQ("verbose\n", config->content());
+}
+
+TEST(ConfigFile, openEmptyFile) {
+    const TemporaryFile file("");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    ASSERT_EQ("", config->content());
+}
+
+TEST(ConfigFile, openReturnsErrorWhenFileIsMissing) {
+    const auto config = yeschief::ConfigFile::open(TempDir() + "yeschief-missing");
+    ASSERT_FALSE(config);
+    ASSERT_EQ(std::errc::no_such_file_or_directory, config.error());
+}
+
+TEST(ConfigFile, runReturnsResultFromConfigFile) {
+    const TemporaryFile file(R"(# Options of name
+foo = 12
+bar = "from file"
+baz = from file
+list = a
+flag
+list = b
+)");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    const EnvironmentVariable baz("YESCHIEF_TEST_BAZ", "from environment");
+    yeschief::CLI cli("name", "description");
+    cli.setConfigFile(&config.value());
+    cli.addOption<int>("foo", "Foo", {.default_value = 1})
+        .addOption<std::string>("bar", "Bar")
+        .addOption<std::string>("baz", "Baz", {.env = "YESCHIEF_TEST_BAZ"})
+        .addOption<std::vector<std::string>>("list", "List")
+        .addOption("flag", "Flag")
+        .addOption<int>("qux", "Qux", {.default_value = 3});
+
+    // Argv takes precedence over the environment, then the config file, then defaults
+    const auto result = cli.run(3, toStringArray({"name", "--bar", "from argv"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, std::any_cast<int>(result->get("foo").value()));
+    ASSERT_EQ("from argv", std::any_cast<std::string>(result->get("bar").value()));
+    ASSERT_EQ("from environment", std::any_cast<std::string>(result->get("baz").value()));
+    ASSERT_THAT(std::any_cast<std::vector<std::string>>(result->get("list").value()), ElementsAre("a", "b"));
+    ASSERT_TRUE(std::any_cast<bool>(result->get("flag").value()));
+    ASSERT_EQ(3, std::any_cast<int>(result->get("qux").value()));
+}
+
+TEST(ConfigFile, runReturnsFaultWhenKeyIsUnknown) {
+    const TemporaryFile file("verbos = true\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    cli.setConfigFile(&config.value()).addOption("verbose", "Verbose");
+
+    const auto result = cli.run(1, toStringArray({"name"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_EQ("verbos", result.error().token);
+    ASSERT_EQ(std::nullopt, result.error().argument_index);
+    ASSERT_EQ(yeschief::TokenSource::ConfigFile, result.error().source);
+    ASSERT_THAT(result.error().suggestions(), ElementsAre("verbose"));
+    // Written as in the file, without dashes
+    ASSERT_EQ("Unrecognized option: verbos, did you mean verbose?", result.error().message());
+}
+
+TEST(ConfigFile, runReturnsFaultWhenValueHasBadType) {
+    const TemporaryFile file("foo = twelve\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    cli.setConfigFile(&config.value()).addOption<int>("foo", "Foo");
+
+    const auto result = cli.run(1, toStringArray({"name"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidOptionType, result.error().type);
+    ASSERT_EQ("foo", result.error().option);
+    ASSERT_EQ("twelve", result.error().token);
+}
+
+TEST(ConfigFile, runReturnsFaultWhenLineIsInvalid) {
+    const TemporaryFile file("[section\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    cli.setConfigFile(&config.value()).addOption("verbose", "Verbose");
+
+    const auto result = cli.run(1, toStringArray({"name"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidConfigFile, result.error().type);
+    ASSERT_EQ("Invalid line in config file: [section", result.error().message());
+}
+
+TEST(ConfigFile, runCollectingFaultsCollectsFaultsOfFile) {
+    const TemporaryFile file("foo = twelve\n[command]\nbar\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    cli.setConfigFile(&config.value()).addOption<int>("foo", "Foo");
+
+    const auto result = cli.runCollectingFaults(1, toStringArray({"name"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_THAT(
+        result.error(),
+        ElementsAre(
+            Field(&yeschief::Fault::type, yeschief::FaultType::UnknownCommand),
+            Field(&yeschief::Fault::type, yeschief::FaultType::InvalidOptionType)
+        )
+    );
+}
+
+TEST(ConfigFile, runCommandReadsSectionOfCommand) {
+    const TemporaryFile file("[my-command]\nexit = 3\n[other-command]\nexit = 4\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    CommandStub other_command("other-command");
+    cli.addCommand(&command).setConfigFile(&config.value()).addCommand(&other_command);
+
+    ASSERT_EQ(3, cli.runCommand(2, toStringArray({"name", "my-command"}).data()).value());
+    ASSERT_EQ(4, cli.runCommand(2, toStringArray({"name", "other-command"}).data()).value());
+    ASSERT_EQ(12, cli.runCommand(3, toStringArray({"name", "my-command", "--exit=12"}).data()).value());
+}
+
+TEST(ConfigFile, runCommandReturnsFaultWhenSectionIsUnknown) {
+    const TemporaryFile file("[my-comand]\nexit = 3\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command).setConfigFile(&config.value());
+
+    const auto result = cli.runCommand(2, toStringArray({"name", "my-command"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnknownCommand, result.error().type);
+    ASSERT_EQ("my-comand", result.error().token);
+    ASSERT_THAT(result.error().suggestions(), ElementsAre("my-command"));
+}
+
+TEST(ConfigFile, runCommandReadsSectionOfNestedCommand) {
+    const TemporaryFile file("[remote.my-command]\nexit = 5\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    ParentCommand remote("remote", &command);
+    cli.setConfigFile(&config.value()).addCommand(&remote);
+    const std::vector<std::string> args = {"name", "remote", "my-command"};
+    auto argv                           = toStringArray(args);
+    yeschief::ParseContext context;
+
+    // Entries of a run are not kept for the next one
+    ASSERT_EQ(5, cli.runCommand(3, argv.data(), context).value());
+    ASSERT_EQ(5, cli.runCommand(3, argv.data(), context).value());
+}
+
+TEST(ConfigFile, runCommandReturnsFaultWhenKeyOfNestedCommandIsUnknown) {
+    const TemporaryFile file("[remote.my-command]\nexi = 5\n");
+    const auto config = yeschief::ConfigFile::open(file.path());
+    ASSERT_TRUE(config);
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    ParentCommand remote("remote", &command);
+    cli.setConfigFile(&config.value()).addCommand(&remote);
+
+    const auto result = cli.runCommand(3, toStringArray({"name", "remote", "my-command"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_EQ("exi", result.error().token);
+    ASSERT_EQ("Unrecognized option: exi, did you mean exit?", result.error().message());
+}
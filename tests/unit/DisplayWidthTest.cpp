@@ -0,0 +1,93 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <gtest/gtest.h>
+#include <string>
+#include <yeschief.h>
+
+TEST(DisplayWidth, empty) {
+    ASSERT_EQ(0, yeschief::displayWidth(""));
+}
+
+TEST(DisplayWidth, ascii) {
+    ASSERT_EQ(5, yeschief::displayWidth("hello"));
+    ASSERT_EQ(43, yeschief::displayWidth("The quick brown fox jumps over the lazy dog"));
+}
+
+TEST(DisplayWidth, twoBytesCharacters) {
+    ASSERT_EQ(5, yeschief::displayWidth("héllo"));
+    ASSERT_EQ(6, yeschief::displayWidth("привет"));
+}
+
+TEST(DisplayWidth, nonAsciiAfterAsciiWords) {
+    ASSERT_EQ(21, yeschief::displayWidth("abcdefghijklmnopé€xyz"));
+}
+
+TEST(DisplayWidth, twoBytesCharactersAcrossWords) {
+    ASSERT_EQ(20, yeschief::displayWidth("abcdefgéабвгдежзийкл"));
+}
+
+TEST(DisplayWidth, combiningMarksInLongText) {
+    ASSERT_EQ(17, yeschief::displayWidth("abcde\u0301fghijklmnopq"));
+}
+
+TEST(DisplayWidth, wideCharactersInLongText) {
+    ASSERT_EQ(18, yeschief::displayWidth("abcdéfgh日本ijklmn"));
+}
+
+TEST(DisplayWidth, combiningMarks) {
+    ASSERT_EQ(5, yeschief::displayWidth("he\u0301llo"));
+}
+
+TEST(DisplayWidth, wideCharacters) {
+    ASSERT_EQ(4, yeschief::displayWidth("日本"));
+    ASSERT_EQ(6, yeschief::displayWidth("한국어"));
+    ASSERT_EQ(2, yeschief::displayWidth("\U0001F600"));
+}
+
+TEST(DisplayWidth, truncatedSequence) {
+    ASSERT_EQ(3, yeschief::displayWidth(std::string("ab\xE6", 3)));
+}
+
+TEST(DisplayWidth, isConstexpr) {
+    static_assert(yeschief::displayWidth("日本 and more ascii") == 19);
+    static_assert(yeschief::displayWidth("abcdefgéабвгдежзийкл") == 20);
+}
+
+TEST(DisplayWidth, appendIndentedLinesWraps) {
+    std::string out;
+    yeschief::appendIndentedLines(out, "one two three four\nfive", "  ", 12);
+    ASSERT_EQ("one two\n  three four\n  five", out);
+}
+
+TEST(DisplayWidth, appendIndentedLinesWrapsOnDisplayWidth) {
+    std::string out;
+    yeschief::appendIndentedLines(out, "日本語 日本語 é", "  ", 10);
+    ASSERT_EQ("日本語\n  日本語 é", out);
+}
+
+TEST(DisplayWidth, appendIndentedLinesKeepsLongWords) {
+    std::string out;
+    yeschief::appendIndentedLines(out, "a verylongword b", "  ", 8);
+    ASSERT_EQ("a\n  verylongword\n  b", out);
+}
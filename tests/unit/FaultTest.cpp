@@ -0,0 +1,166 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+TEST(Fault, messageInvalidArgs) {
+    ASSERT_EQ(
+        "argc cannot be less than 1, argv should at least contains executable name",
+        yeschief::Fault{.type = yeschief::FaultType::InvalidArgs}.message()
+    );
+}
+
+TEST(Fault, messageUnrecognizedOption) {
+    ASSERT_EQ(
+        "Unrecognized option: foo",
+        yeschief::Fault({.type = yeschief::FaultType::UnrecognizedOption, .token = "foo"}).message()
+    );
+}
+
+TEST(Fault, messageMissingRequiredOption) {
+    ASSERT_EQ(
+        "Some required options were not given: foo, bar",
+        yeschief::Fault({
+                          .type            = yeschief::FaultType::MissingRequiredOption,
+                          .option          = "foo",
+                          .missing_options = {"foo", "bar"},
+                        })
+            .message()
+    );
+}
+
+TEST(Fault, messageInvalidOptionType) {
+    ASSERT_EQ(
+        "'foo' cannot be parsed to a boolean value",
+        yeschief::Fault({.type = yeschief::FaultType::InvalidOptionType, .token = "foo", .expected_type = "boolean"})
+            .message()
+    );
+    ASSERT_EQ(
+        "'foo' cannot be parsed to an int value",
+        yeschief::Fault({.type = yeschief::FaultType::InvalidOptionType, .token = "foo", .expected_type = "int"})
+            .message()
+    );
+}
+
+TEST(Fault, messageMissingOptionValue) {
+    ASSERT_EQ(
+        "Option 'foo' needs a value",
+        yeschief::Fault({.type = yeschief::FaultType::MissingOptionValue, .option = "foo"}).message()
+    );
+}
+
+TEST(Fault, messageUnknownCommand) {
+    ASSERT_EQ(
+        "Command 'foo' not found",
+        yeschief::Fault({.type = yeschief::FaultType::UnknownCommand, .token = "foo"}).message()
+    );
+}
+
+TEST(Fault, messageAmbiguousPrefix) {
+    ASSERT_EQ(
+        "'ver' is ambiguous, it may be: --verbose, --version",
+        yeschief::Fault({
+                            .type       = yeschief::FaultType::AmbiguousPrefix,
+                            .token      = "ver",
+                            .candidates = {"verbose", "version"},
+                        })
+            .message()
+    );
+
+    yeschief::CLI cli("name", "description");
+    CommandStub stash("stash");
+    CommandStub status("status");
+    cli.addCommand(&stash).addCommand(&status);
+    ASSERT_EQ(
+        "'st' is ambiguous, it may be: stash, status",
+        yeschief::Fault({
+                            .type       = yeschief::FaultType::AmbiguousPrefix,
+                            .token      = "st",
+                            .candidates = {"stash", "status"},
+                            .cli        = &cli,
+                        })
+            .message()
+    );
+}
+
+TEST(Fault, messageUnserializableValue) {
+    ASSERT_EQ(
+        "Value of option 'foo' has not the type of an option, it cannot be serialized",
+        yeschief::Fault({.type = yeschief::FaultType::UnserializableValue, .option = "foo"}).message()
+    );
+}
+
+TEST(Fault, messageInvalidSchema) {
+    ASSERT_EQ(
+        "Schema describes options or commands that cannot be added to its CLI",
+        yeschief::Fault{.type = yeschief::FaultType::InvalidSchema}.message()
+    );
+}
+
+TEST(Fault, faultTypeIsAnErrorCode) {
+    const std::error_code code = yeschief::FaultType::InvalidSchema;
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, code);
+    ASSERT_STREQ("yeschief", code.category().name());
+    ASSERT_NE(std::make_error_code(std::errc::illegal_byte_sequence), code);
+}
+
+TEST(Fault, messageSuggestsCandidates) {
+    yeschief::CLI options_cli("name", "description");
+    options_cli.addOption("verbose", "Verbose").addOption("input", "Input");
+    ASSERT_EQ(
+        "Unrecognized option: verbos, did you mean --verbose?",
+        yeschief::Fault({
+                            .type  = yeschief::FaultType::UnrecognizedOption,
+                            .token = "verbos",
+                            .cli   = &options_cli,
+                        })
+            .message()
+    );
+
+    yeschief::CLI commands_cli("name", "description");
+    CommandStub stars("stars");
+    CommandStub stat("stat");
+    CommandStub status("status");
+    commands_cli.addCommand(&stars).addCommand(&stat).addCommand(&status);
+    ASSERT_EQ(
+        "Command 'stats' not found, did you mean stars, stat or status?",
+        yeschief::Fault({
+                            .type  = yeschief::FaultType::UnknownCommand,
+                            .token = "stats",
+                            .cli   = &commands_cli,
+                        })
+            .message()
+    );
+}
+
+TEST(Fault, suggestionsWithoutCLI) {
+    ASSERT_THAT(
+        yeschief::Fault({.type = yeschief::FaultType::UnrecognizedOption, .token = "verbos"}).suggestions(), IsEmpty()
+    );
+}
@@ -0,0 +1,161 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+TEST(IncrementalParser, expectsOptionOrPositionalAtStart) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "bar");
+    cli.parsePositional("foo");
+    const yeschief::IncrementalParser parser(cli);
+    const auto expectation = parser.expects();
+    ASSERT_EQ(yeschief::ExpectationType::OptionOrPositional, expectation.type);
+    ASSERT_EQ("foo", expectation.option->name);
+}
+
+TEST(IncrementalParser, expectsValueAfterOption) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "bar");
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("-f"));
+    const auto expectation = parser.expects();
+    ASSERT_EQ(yeschief::ExpectationType::OptionValue, expectation.type);
+    ASSERT_EQ("foo", expectation.option->name);
+    ASSERT_EQ(yeschief::OptionType::Int, expectation.option->type);
+
+    ASSERT_TRUE(parser.push("12"));
+    ASSERT_EQ(yeschief::ExpectationType::OptionOrPositional, parser.expects().type);
+    ASSERT_EQ(nullptr, parser.expects().option);
+}
+
+TEST(IncrementalParser, expectsPositionalAfterDoubleDash) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::string>("first", "bar").addOption<std::vector<int>>("others", "baz");
+    cli.parsePositional("first", "others");
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("--"));
+    ASSERT_EQ(yeschief::ExpectationType::Positional, parser.expects().type);
+    ASSERT_EQ("first", parser.expects().option->name);
+    ASSERT_TRUE(parser.push("hello"));
+    ASSERT_EQ("others", parser.expects().option->name);
+    ASSERT_TRUE(parser.push("1"));
+    ASSERT_TRUE(parser.push("2"));
+    ASSERT_EQ(yeschief::ExpectationType::Positional, parser.expects().type);
+    ASSERT_EQ("others", parser.expects().option->name);
+}
+
+TEST(IncrementalParser, expectsNothingWhenNoPositional) {
+    const yeschief::CLI cli("name", "description");
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("--"));
+    ASSERT_EQ(yeschief::ExpectationType::Nothing, parser.expects().type);
+}
+
+TEST(IncrementalParser, pushReturnsFaultWhenUnrecognizedOption) {
+    const yeschief::CLI cli("name", "description");
+    yeschief::IncrementalParser parser(cli);
+    const auto result = parser.push("--foo");
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_EQ("foo", result.error().token);
+    ASSERT_EQ(1, result.error().argument_index);
+}
+
+TEST(IncrementalParser, finishReturnsSameResultsAsRun) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?").addOption("verbose,v", "Verbose");
+    yeschief::IncrementalParser parser(cli);
+    for (const auto &argument : {"--foo=2", "-v", "-f", "45"}) {
+        ASSERT_TRUE(parser.push(argument));
+    }
+    const auto result = parser.finish();
+    ASSERT_TRUE(result);
+    ASSERT_EQ(45, std::any_cast<int>(result->get("foo").value()));
+    ASSERT_TRUE(std::any_cast<bool>(result->get("verbose").value()));
+}
+
+TEST(IncrementalParser, finishReturnsFaultWhenMissingRequiredOption) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("foo", "Bar?", {.required = true});
+    const yeschief::IncrementalParser parser(cli);
+    const auto result = parser.finish();
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::MissingRequiredOption, result.error().type);
+}
+
+TEST(IncrementalParser, finishDoesNotAlterState) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "Bar?", {.implicit_value = 3});
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("--foo"));
+    ASSERT_EQ(3, std::any_cast<int>(parser.finish()->get("foo").value()));
+    ASSERT_TRUE(parser.push("7"));
+    ASSERT_EQ(7, std::any_cast<int>(parser.finish()->get("foo").value()));
+}
+
+TEST(IncrementalParser, copyIsIndependent) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "Bar?");
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("--foo"));
+    const auto snapshot = parser;
+    ASSERT_TRUE(parser.push("1"));
+    ASSERT_EQ(yeschief::ExpectationType::OptionOrPositional, parser.expects().type);
+    ASSERT_EQ(yeschief::ExpectationType::OptionValue, snapshot.expects().type);
+}
+
+TEST(IncrementalParser, reset) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo", "Bar?");
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_TRUE(parser.push("--foo"));
+    parser.reset();
+    ASSERT_EQ(yeschief::ExpectationType::OptionOrPositional, parser.expects().type);
+    ASSERT_EQ(std::nullopt, parser.finish()->get("foo"));
+}
+
+TEST(IncrementalParser, commands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    yeschief::IncrementalParser parser(cli);
+    ASSERT_EQ(yeschief::ExpectationType::Command, parser.expects().type);
+
+    const auto unknown = parser.push("other");
+    ASSERT_FALSE(unknown);
+    ASSERT_EQ(yeschief::FaultType::UnknownCommand, unknown.error().type);
+    ASSERT_EQ("other", unknown.error().token);
+
+    ASSERT_TRUE(parser.push("my-command"));
+    ASSERT_TRUE(parser.push("--exit"));
+    ASSERT_EQ(yeschief::ExpectationType::OptionValue, parser.expects().type);
+    ASSERT_EQ("exit", parser.expects().option->name);
+    ASSERT_TRUE(parser.push("12"));
+    ASSERT_EQ(12, std::any_cast<int>(parser.finish()->get("exit").value()));
+}
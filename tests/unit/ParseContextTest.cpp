@@ -0,0 +1,90 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+TEST(ParseContext, runReturnsResults) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+    yeschief::ParseContext context;
+    const auto result = cli.run(3, toStringArray({"name", "-f", "12"}).data(), context);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, std::any_cast<int>(result->get().get("foo").value()));
+}
+
+TEST(ParseContext, runDoesNotKeepPreviousResults) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?").addOption<int>("bar", "Foo?", {.default_value = 3});
+    yeschief::ParseContext context;
+    ASSERT_TRUE(cli.run(4, toStringArray({"name", "-f", "12", "--bar=4"}).data(), context));
+
+    const auto result = cli.run(1, toStringArray({"name"}).data(), context);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(std::nullopt, result->get().get("foo"));
+    ASSERT_EQ(3, std::any_cast<int>(result->get().get("bar").value()));
+}
+
+TEST(ParseContext, runAfterFault) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+    yeschief::ParseContext context;
+    const auto fault = cli.run(3, toStringArray({"name", "-f", "twelve"}).data(), context);
+    ASSERT_FALSE(fault);
+    ASSERT_EQ(yeschief::FaultType::InvalidOptionType, fault.error().type);
+
+    const auto result = cli.run(2, toStringArray({"name", "--foo=1"}).data(), context);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(1, std::any_cast<int>(result->get().get("foo").value()));
+}
+
+TEST(ParseContext, runWithDifferentCLIs) {
+    yeschief::CLI first("first", "description");
+    first.addOption<std::vector<std::string>>("foo", "Bar?");
+    first.parsePositional("foo");
+    yeschief::CLI second("second", "description");
+    second.addOption<std::string>("bar", "Foo?");
+    second.parsePositional("bar");
+    yeschief::ParseContext context;
+    ASSERT_TRUE(first.run(4, toStringArray({"first", "a", "b", "c"}).data(), context));
+
+    const auto result = second.run(2, toStringArray({"second", "d"}).data(), context);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(std::nullopt, result->get().get("foo"));
+    ASSERT_STREQ("d", std::any_cast<std::string>(result->get().get("bar").value()).c_str());
+}
+
+TEST(ParseContext, runCommand) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    yeschief::ParseContext context;
+    ASSERT_EXIT(
+        cli.run(3, toStringArray({"name", "my-command", "--exit=12"}).data(), context), ExitedWithCode(12), ".*"
+    );
+}
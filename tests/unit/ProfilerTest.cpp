@@ -0,0 +1,201 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+class ProfilerStub final : public yeschief::Profiler {
+  public:
+    auto record(const yeschief::RunProfile &profile) -> void override {
+        profiles.push_back(profile);
+    }
+
+    std::vector<yeschief::RunProfile> profiles;
+};
+
+namespace {
+/**
+ * Phases may take less than a tick of the clock: only check the durations of profile are consistent, not that they are
+ * positive
+ */
+auto assertDurationsAreConsistent(const yeschief::RunProfile &profile) -> void {
+    std::chrono::nanoseconds phases{0};
+    for (const auto duration : profile.durations) {
+        ASSERT_GE(duration.count(), 0);
+        phases += duration;
+    }
+    ASSERT_GE(profile.total, phases);
+    ASSERT_GE(profile.command.count(), 0);
+}
+} // namespace
+
+TEST(Profiler, runRecordsProfile) {
+    ProfilerStub profiler;
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?")
+        .addOption<std::vector<int>>("numbers", "Numbers")
+        .addOption<std::string>("label", "Label", {.default_value = std::string("none")});
+    cli.parsePositional("numbers");
+    cli.setProfiler(&profiler);
+
+    ASSERT_TRUE(cli.run(5, toStringArray({"name", "-f", "12", "1", "2"}).data()));
+    ASSERT_THAT(profiler.profiles, SizeIs(1));
+    const auto &profile = profiler.profiles[0];
+    ASSERT_EQ(4, profile.tokens);
+    ASSERT_EQ(2, profile.options_matched);
+    ASSERT_EQ(3, profile.values_converted);
+    ASSERT_EQ(0, profile.duration(yeschief::ProfilePhase::CommandDispatch).count());
+    assertDurationsAreConsistent(profile);
+}
+
+TEST(Profiler, runRecordsFailedRuns) {
+    ProfilerStub profiler;
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?", {.required = true});
+    cli.setProfiler(&profiler);
+
+    ASSERT_FALSE(cli.run(1, toStringArray({"name"}).data()));
+    ASSERT_FALSE(cli.run(2, toStringArray({"name", "--unknown"}).data()));
+    ASSERT_THAT(profiler.profiles, SizeIs(2));
+    assertDurationsAreConsistent(profiler.profiles[0]);
+    assertDurationsAreConsistent(profiler.profiles[1]);
+}
+
+TEST(Profiler, runCommandRecordsDispatch) {
+    ProfilerStub profiler;
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    cli.setProfiler(&profiler);
+
+    const auto result = cli.runCommand(3, toStringArray({"name", "my-command", "--exit=3"}).data());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(3, result->value());
+    ASSERT_THAT(profiler.profiles, SizeIs(1));
+    const auto &profile = profiler.profiles[0];
+    ASSERT_EQ(2, profile.tokens);
+    ASSERT_EQ(1, profile.options_matched);
+    assertDurationsAreConsistent(profile);
+}
+
+TEST(Profiler, profileSwitchPrintsProfile) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+
+    std::stringstream err;
+    const auto cerr_buffer = std::cerr.rdbuf(err.rdbuf());
+    const auto result      = cli.run(4, toStringArray({"name", "--yeschief-profile", "-f", "12"}).data());
+    std::cerr.rdbuf(cerr_buffer);
+    const auto output = err.str();
+    ASSERT_TRUE(result);
+    ASSERT_EQ(12, std::any_cast<int>(result->get("foo").value()));
+    ASSERT_THAT(output, HasSubstr("yeschief profile: 2 tokens, 1 options matched, 1 values converted"));
+    ASSERT_THAT(output, HasSubstr("tokenize"));
+}
+
+TEST(Profiler, profileSwitchOnlyAsFirstArgument) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+
+    const auto result = cli.run(4, toStringArray({"name", "-f", "12", "--yeschief-profile"}).data());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+}
+
+TEST(Profiler, profileSwitchLocatesFaultsInArgv) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+
+    std::stringstream err;
+    const auto cerr_buffer = std::cerr.rdbuf(err.rdbuf());
+    const auto result      = cli.run(3, toStringArray({"name", "--yeschief-profile", "--unknown"}).data());
+    std::cerr.rdbuf(cerr_buffer);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_EQ(2, result.error().argument_index);
+}
+
+TEST(Profiler, profileSwitchPrintsCommandProfile) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    std::stringstream err;
+    const auto cerr_buffer = std::cerr.rdbuf(err.rdbuf());
+    const auto result      = cli.runCommand(3, toStringArray({"name", "--yeschief-profile", "my-command"}).data());
+    std::cerr.rdbuf(cerr_buffer);
+    ASSERT_TRUE(result);
+    ASSERT_EQ(0, result->value());
+    ASSERT_THAT(err.str(), HasSubstr("command dispatch"));
+}
+
+TEST(Profiler, profileSwitchIgnoredByContextAndBatchRuns) {
+    ProfilerStub profiler;
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("foo,f", "Bar?");
+    cli.setProfiler(&profiler);
+    const std::vector<std::string> args = {"name", "--yeschief-profile", "-f", "12"};
+
+    std::stringstream err;
+    const auto cerr_buffer = std::cerr.rdbuf(err.rdbuf());
+    yeschief::ParseContext context;
+    const auto result  = cli.run(4, toStringArray(args).data(), context);
+    const auto results = cli.runBatch(std::vector<std::vector<std::string>>{args});
+    std::cerr.rdbuf(cerr_buffer);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, result.error().type);
+    ASSERT_THAT(results, SizeIs(1));
+    ASSERT_FALSE(results[0]);
+    ASSERT_EQ(yeschief::FaultType::UnrecognizedOption, results[0].error().type);
+    ASSERT_THAT(err.str(), IsEmpty());
+    ASSERT_THAT(profiler.profiles, SizeIs(2));
+}
+
+TEST(Profiler, printProfile) {
+    yeschief::RunProfile profile;
+    profile.tokens                                                            = 3;
+    profile.options_matched                                                   = 2;
+    profile.values_converted                                                  = 1;
+    profile.durations[static_cast<size_t>(yeschief::ProfilePhase::Conversion)] = std::chrono::microseconds(42);
+    profile.total                                                             = std::chrono::microseconds(100);
+
+    std::stringstream out;
+    yeschief::printProfile(profile, out);
+    ASSERT_EQ(
+        "yeschief profile: 3 tokens, 2 options matched, 1 values converted\n"
+        "  tokenize                 0.000 us\n"
+        "  lookup                   0.000 us\n"
+        "  conversion              42.000 us\n"
+        "  defaults                 0.000 us\n"
+        "  required checks          0.000 us\n"
+        "  command dispatch         0.000 us\n"
+        "  total                  100.000 us\n",
+        out.str()
+    );
+}
@@ -0,0 +1,253 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <cstdio>
+#include <fstream>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+namespace {
+auto configure(yeschief::CLI &cli) -> void {
+    cli.addOption("verbose,v", "Verbose output")
+        .addOption<int>("jobs,j", "Count of jobs", {.value_help = "COUNT", .default_value = 4, .env = "MY_JOBS"})
+        .addOption<std::string>("output", "Output \"file\"", {.implicit_value = std::string("-")})
+        .addOption<std::vector<double>>("ratios", "Ratios", {.default_value = std::vector{0.5, 2.0}})
+        .addOption<std::string>("input", "Input file", {.required = true});
+    cli.addGroup("Advanced")
+        .addOption<float>("threshold", "Threshold")
+        .addOption<std::vector<std::string>>("tags", "Tags");
+    cli.parsePositional("input");
+}
+
+/**
+ * @return schema of a CLI named "name" with "description" as description, its mode replaced by mode
+ */
+auto withMode(std::string schema, const uint8_t mode) -> std::string {
+    // Magic, then name and description, each with its size
+    constexpr size_t mode_offset = 4 + 4 + std::string_view("name").size() + 4 + std::string_view("description").size();
+    schema[mode_offset]          = static_cast<char>(mode);
+    return schema;
+}
+
+auto helpOf(const yeschief::CLI &cli) -> std::string {
+    std::stringstream ss;
+    cli.help(ss);
+    return ss.str();
+}
+} // namespace
+
+TEST(Schema, loadSchemaConfiguresTheExportedCLI) {
+    yeschief::CLI cli("name", "description");
+    cli.setHelpWidth(0);
+    configure(cli);
+
+    yeschief::CLI loaded_cli("", "");
+    loaded_cli.setHelpWidth(0);
+    ASSERT_TRUE(loaded_cli.loadSchema(cli.exportSchema()));
+    ASSERT_EQ(helpOf(cli), helpOf(loaded_cli));
+    ASSERT_EQ(cli.fingerprint(), loaded_cli.fingerprint());
+
+    const std::vector<std::string> arguments = {"name", "-v", "--tags=a", "--tags=b", "--input=file.txt"};
+    const auto result = loaded_cli.run(5, toStringArray(arguments).data());
+    ASSERT_TRUE(result);
+    ASSERT_TRUE(std::any_cast<bool>(result->get("verbose").value()));
+    ASSERT_EQ(4, std::any_cast<int>(result->get("jobs").value()));
+    ASSERT_THAT(std::any_cast<std::vector<double>>(result->get("ratios").value()), ElementsAre(0.5, 2.0));
+    ASSERT_EQ("file.txt", std::any_cast<std::string>(result->get("input").value()));
+    ASSERT_THAT(std::any_cast<std::vector<std::string>>(result->get("tags").value()), ElementsAre("a", "b"));
+    ASSERT_EQ(std::nullopt, result->get("threshold"));
+
+    const auto implicit = loaded_cli.run(3, toStringArray({"name", "--input=file.txt", "--output"}).data());
+    ASSERT_TRUE(implicit);
+    ASSERT_EQ("-", std::any_cast<std::string>(implicit->get("output").value()));
+}
+
+TEST(Schema, loadSchemaBindsCommands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    yeschief::CLI loaded_cli("", "");
+    CommandStub loaded_command("my-command");
+    ASSERT_TRUE(loaded_cli.loadSchema(cli.exportSchema(), {{"my-command", &loaded_command}}));
+    ASSERT_EQ(cli.fingerprint(), loaded_cli.fingerprint());
+    ASSERT_EQ(12, loaded_cli.runCommand(3, toStringArray({"name", "my-command", "--exit=12"}).data()).value());
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenCommandIsMissing) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    yeschief::CLI loaded_cli("", "");
+    const auto result = loaded_cli.loadSchema(cli.exportSchema());
+    ASSERT_FALSE(result);
+    ASSERT_EQ(std::errc::invalid_argument, result.error());
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenSchemaIsTruncated) {
+    yeschief::CLI cli("name", "description");
+    configure(cli);
+    const auto schema = cli.exportSchema();
+
+    for (size_t size = 0; size < schema.size(); size++) {
+        yeschief::CLI loaded_cli("", "");
+        const auto result = loaded_cli.loadSchema(std::string_view(schema).substr(0, size));
+        ASSERT_FALSE(result);
+        ASSERT_EQ(std::errc::illegal_byte_sequence, result.error());
+    }
+}
+
+TEST(Schema, exportSchemaSkipsValuesNotOfTheOptionType) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<float>("threshold", "Threshold", {.default_value = 1, .implicit_value = 2.0F});
+
+    yeschief::CLI loaded_cli("", "");
+    ASSERT_TRUE(loaded_cli.loadSchema(cli.exportSchema()));
+    ASSERT_EQ(std::nullopt, loaded_cli.run(1, toStringArray({"name"}).data())->get("threshold"));
+    const auto implicit = loaded_cli.run(2, toStringArray({"name", "--threshold"}).data());
+    ASSERT_EQ(2.0F, std::any_cast<float>(implicit->get("threshold").value()));
+    ASSERT_THAT(cli.exportSchemaJson(), Not(HasSubstr("default_value")));
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenValueHasNotTheOptionType) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<int>("number", "Number", {.default_value = 4});
+    auto schema = cli.exportSchema();
+    // Type of the option, written right after its description
+    schema[schema.find("Number") + 6] = static_cast<char>(yeschief::OptionType::Float);
+
+    yeschief::CLI loaded_cli("", "");
+    const auto result = loaded_cli.loadSchema(schema);
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, result.error());
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenNamesAreDuplicated) {
+    yeschief::CLI options_cli("name", "description");
+    options_cli.addOption("first", "First").addOption("other", "Other");
+    auto options_schema = options_cli.exportSchema();
+    options_schema.replace(options_schema.find("other"), 5, "first");
+
+    yeschief::CLI loaded_options_cli("", "");
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, loaded_options_cli.loadSchema(options_schema).error());
+
+    yeschief::CLI commands_cli("name", "description");
+    CommandStub first("cmd-a");
+    CommandStub other("cmd-b");
+    commands_cli.addCommand(&first).addCommand(&other);
+    auto commands_schema = commands_cli.exportSchema();
+    for (auto position = commands_schema.find("cmd-b"); position != std::string::npos;
+         position      = commands_schema.find("cmd-b")) {
+        commands_schema.replace(position, 5, "cmd-a");
+    }
+
+    yeschief::CLI loaded_commands_cli("", "");
+    CommandStub loaded_command("cmd-a");
+    ASSERT_EQ(
+        yeschief::FaultType::InvalidSchema,
+        loaded_commands_cli.loadSchema(commands_schema, {{"cmd-a", &loaded_command}}).error()
+    );
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenOptionsModeHasCommands) {
+    yeschief::CLI cli("name", "description");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+
+    yeschief::CLI loaded_cli("", "");
+    CommandStub loaded_command("my-command");
+    const auto result = loaded_cli.loadSchema(withMode(cli.exportSchema(), 1), {{"my-command", &loaded_command}});
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, result.error());
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenCommandsModeHasOptions) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption<std::string>("input", "Input file");
+    cli.parsePositional("input");
+
+    yeschief::CLI loaded_cli("", "");
+    const auto result = loaded_cli.loadSchema(withMode(cli.exportSchema(), 2));
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, result.error());
+}
+
+TEST(Schema, loadSchemaReturnsErrorWhenNoModeHasOptions) {
+    yeschief::CLI cli("name", "description");
+    cli.addOption("verbose", "Verbose");
+
+    yeschief::CLI loaded_cli("", "");
+    const auto result = loaded_cli.loadSchema(withMode(cli.exportSchema(), 0));
+    ASSERT_FALSE(result);
+    ASSERT_EQ(yeschief::FaultType::InvalidSchema, result.error());
+    ASSERT_EQ("Schema describes options or commands that cannot be added to its CLI", result.error().message());
+}
+
+TEST(Schema, loadSchemaFileMapsFile) {
+    yeschief::CLI cli("name", "description");
+    configure(cli);
+    const auto path = TempDir() + "yeschief-schema";
+    std::ofstream(path) << cli.exportSchema();
+
+    yeschief::CLI loaded_cli("", "");
+    const auto result = loaded_cli.loadSchemaFile(path);
+    std::remove(path.c_str());
+    ASSERT_TRUE(result);
+    ASSERT_EQ(cli.fingerprint(), loaded_cli.fingerprint());
+
+    ASSERT_EQ(std::errc::no_such_file_or_directory, loaded_cli.loadSchemaFile(path).error());
+}
+
+TEST(Schema, exportSchemaJson) {
+    yeschief::CLI cli("name", "A \"quoted\"\ndescription");
+    CommandStub command("my-command");
+    cli.addCommand(&command);
+    yeschief::CLI options_cli("name", "description");
+    options_cli.addOption<std::vector<int>>("numbers,n", "Numbers", {.default_value = std::vector{1, 2}});
+    options_cli.addOption<double>("ratio", "Ratio", {.required = true, .env = "RATIO"});
+    options_cli.parsePositional("ratio");
+
+    ASSERT_EQ(
+        R"({"name": "name", "description": "A \"quoted\"\ndescription", "options": [], "positional": [], )"
+        R"("commands": [{"name": "my-command", "description": "Stub class for Command.\nDescription on another )"
+        R"(line.", "options": [{"name": "exit", "short_name": "", "description": "Exit code of command", )"
+        R"("group": "", "type": "int", "required": false, "value_help": "VALUE", "env": ""}], "positional": [], )"
+        R"("commands": []}]})",
+        cli.exportSchemaJson()
+    );
+    ASSERT_EQ(
+        R"({"name": "name", "description": "description", "options": [{"name": "numbers", "short_name": "n", )"
+        R"("description": "Numbers", "group": "", "type": "int list", "required": false, "value_help": "VALUE", )"
+        R"("env": "", "default_value": [1, 2]}, {"name": "ratio", "short_name": "", "description": "Ratio", )"
+        R"("group": "", "type": "double", "required": true, "value_help": "VALUE", "env": "RATIO"}], )"
+        R"("positional": ["ratio"], "commands": []})",
+        options_cli.exportSchemaJson()
+    );
+}
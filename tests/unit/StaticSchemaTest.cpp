@@ -0,0 +1,121 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2025-Present Kevin Traini
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "test_tools.hpp"
+
+#include <array>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string_view>
+#include <yeschief.h>
+
+using namespace ::testing;
+
+namespace {
+constexpr std::array<yeschief::StaticOption, 5> options = {{
+  {.name        = "name",
+   .short_name  = "n",
+   .description = "My option",
+   .type        = yeschief::OptionType::String,
+   .required    = true,
+   .value_help  = "VALUE",
+   .group       = "",
+   .env         = ""},
+  {.name        = "help",
+   .short_name  = "",
+   .description = "Multiline\nhelp message",
+   .type        = yeschief::OptionType::Boolean,
+   .required    = false,
+   .value_help  = "VALUE",
+   .group       = "",
+   .env         = ""},
+  {.name        = "number",
+   .short_name  = "",
+   .description = "A number",
+   .type        = yeschief::OptionType::Int,
+   .required    = false,
+   .value_help  = "<n>",
+   .group       = "",
+   .env         = ""},
+  {.name        = "character",
+   .short_name  = "",
+   .description = "A character",
+   .type        = yeschief::OptionType::String,
+   .required    = true,
+   .value_help  = "VALUE",
+   .group       = "",
+   .env         = ""},
+  {.name        = "rand",
+   .short_name  = "",
+   .description = "Display a random number",
+   .type        = yeschief::OptionType::Boolean,
+   .required    = false,
+   .value_help  = "VALUE",
+   .group       = "Special",
+   .env         = ""},
+}};
+constexpr std::array<std::string_view, 2> positional = {"character", "number"};
+constexpr yeschief::StaticSchema schema              = {"cli", "description", options, positional};
+} // namespace
+
+TEST(StaticSchema, staticHelpIsRenderedAtCompileTime) {
+    static constexpr auto help = yeschief::staticHelp<schema>();
+    static_assert(std::string_view(help.data(), help.size()).starts_with("usage:\n  cli [OPTIONS] --name CHARACTER"));
+
+    yeschief::CLI cli("cli", "description");
+    cli.addOption<std::string>("name,n", "My option", {.required = true}).addOption("help", "Multiline\nhelp message");
+    cli.addOption<int>("number", "A number", {.value_help = "<n>"})
+        .addOption<std::string>("character", "A character", {.required = true});
+    cli.parsePositional("character", "number");
+    cli.addGroup("Special").addOption("rand", "Display a random number");
+    std::stringstream ss;
+    cli.help(ss);
+
+    ASSERT_EQ(ss.str(), std::string_view(help.data(), help.size()));
+}
+
+TEST(StaticSchema, cliBuiltFromSchemaHasSameHelp) {
+    const yeschief::CLI cli(schema);
+    std::stringstream ss;
+    cli.help(ss);
+
+    ASSERT_EQ(yeschief::renderHelp(schema), ss.str());
+}
+
+TEST(StaticSchema, cliBuiltFromSchemaParses) {
+    const yeschief::CLI cli(schema);
+    const auto result = cli.run(6, toStringArray({"cli", "-n", "foo", "--rand", "--", "c"}).data());
+
+    ASSERT_TRUE(result.has_value());
+    ASSERT_EQ("foo", std::any_cast<std::string>(result->get("name").value()));
+    ASSERT_TRUE(std::any_cast<bool>(result->get("rand").value()));
+    ASSERT_EQ("c", std::any_cast<std::string>(result->get("character").value()));
+}
+
+TEST(StaticSchema, renderUsageHelpWithoutOptions) {
+    static_assert(
+        yeschief::renderUsageHelp({.name = "my-program", .description = "", .options = {}, .positional = {}})
+        == "my-program"
+    );
+}
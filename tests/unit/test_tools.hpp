@@ -24,6 +24,7 @@
 #ifndef TEST_TOOLS_H
 #define TEST_TOOLS_H
 
+#include <cstdlib>
 #include <string>
 #include <utility>
 #include <vector>
@@ -65,4 +66,52 @@ class CommandStub final : public yeschief::Command {
     std::string _name;
 };
 
+/**
+ * Command having one command of its own
+ */
+class ParentCommand final : public yeschief::Command {
+  public:
+    ParentCommand(std::string name, yeschief::Command *command): _name(std::move(name)), _command(command) {}
+
+    [[nodiscard]] auto getName() const -> std::string override {
+        return _name;
+    }
+
+    [[nodiscard]] auto getDescription() const -> std::string override {
+        return "Parent";
+    }
+
+    auto setup(yeschief::CLI &cli) -> void override {
+        cli.addCommand(_command);
+    }
+
+    auto run(const yeschief::CLIResults &) -> int override {
+        return 0;
+    }
+
+  private:
+    std::string _name;
+    yeschief::Command *_command;
+};
+
+/**
+ * Set an environment variable, removed when it goes out of scope, even when an assertion fails before
+ */
+class EnvironmentVariable final {
+  public:
+    EnvironmentVariable(std::string name, const std::string &value): _name(std::move(name)) {
+        setenv(_name.c_str(), value.c_str(), 1);
+    }
+
+    EnvironmentVariable(const EnvironmentVariable &)                    = delete;
+    auto operator=(const EnvironmentVariable &) -> EnvironmentVariable & = delete;
+
+    ~EnvironmentVariable() {
+        unsetenv(_name.c_str());
+    }
+
+  private:
+    std::string _name;
+};
+
 #endif // TEST_TOOLS_H
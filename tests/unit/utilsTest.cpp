@@ -25,8 +25,11 @@
 
 #include "test_tools.hpp"
 
+#include <atomic>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <sstream>
+#include <thread>
 
 using namespace ::testing;
 
@@ -62,6 +65,38 @@ TEST(utils, splitOnLongString) {
     ASSERT_THAT(yeschief::split("ahellobhelloc", "hello"), ElementsAre("a", "b", "c"));
 }
 
+TEST(utils, splitSkipsEmptyParts) {
+    ASSERT_THAT(yeschief::split("a\nb\n\nc\n", "\n"), ElementsAre("a", "b", "c"));
+}
+
+TEST(utils, splitReturnsViewsIntoString) {
+    const std::string str = "first second";
+    const auto parts      = yeschief::split(str, " ");
+    ASSERT_EQ(str.data(), parts[0].data());
+    ASSERT_EQ(str.data() + 6, parts[1].data());
+}
+
+TEST(utils, joinSplitView) {
+    ASSERT_STREQ("a\n  b\n  c", yeschief::join(yeschief::splitView("a\nb\n\nc", "\n"), "\n  ").c_str());
+}
+
+TEST(utils, joinStringViews) {
+    const std::vector<std::string_view> strings = {"a", "b", "c"};
+    ASSERT_STREQ("a, b, c", yeschief::join(strings, ", ").c_str());
+}
+
+TEST(utils, appendJoinedKeepsContent) {
+    std::string out = "start: ";
+    yeschief::appendJoined(out, yeschief::splitView("a b", " "), ", ");
+    ASSERT_STREQ("start: a, b", out.c_str());
+}
+
+TEST(utils, appendJoinedNothing) {
+    std::string out = "start";
+    yeschief::appendJoined(out, yeschief::splitView("", " "), ", ");
+    ASSERT_STREQ("start", out.c_str());
+}
+
 TEST(utils, inArray) {
     ASSERT_TRUE(yeschief::inArray({"a", "b", "c"}, "a"));
     ASSERT_TRUE(yeschief::inArray({"a", "b", "c"}, "b"));
@@ -69,6 +104,49 @@ TEST(utils, inArray) {
     ASSERT_FALSE(yeschief::inArray({"a", "b", "c"}, "d"));
 }
 
+TEST(utils, prefixIndexFindsNamesStartingWithPrefix) {
+    const yeschief::PrefixIndex index(std::vector<std::string>{"verbose", "version", "value", "v", "size"});
+    ASSERT_THAT(index.find("ver"), ElementsAre("verbose", "version"));
+    ASSERT_THAT(index.find("verb"), ElementsAre("verbose"));
+    ASSERT_THAT(index.find("v"), ElementsAre("v", "value", "verbose", "version"));
+    ASSERT_THAT(index.find("version"), ElementsAre("version"));
+    ASSERT_THAT(index.find("versions"), IsEmpty());
+    ASSERT_THAT(index.find("x"), IsEmpty());
+    ASSERT_THAT(index.find(""), SizeIs(5));
+}
+
+TEST(utils, prefixIndexOrdersBytesLikeStrings) {
+    const yeschief::PrefixIndex index(std::vector<std::string>{"é", "e", "z"});
+    ASSERT_THAT(index.find("\xC3"), ElementsAre("é"));
+    ASSERT_THAT(index.find("z"), ElementsAre("z"));
+}
+
+TEST(utils, editDistance) {
+    ASSERT_EQ(0, yeschief::EditDistance("verbose").to("verbose"));
+    ASSERT_EQ(1, yeschief::EditDistance("verbos").to("verbose"));
+    ASSERT_EQ(2, yeschief::EditDistance("vrebose").to("verbose"));
+    ASSERT_EQ(3, yeschief::EditDistance("kitten").to("sitting"));
+    ASSERT_EQ(7, yeschief::EditDistance("verbose").to(""));
+    ASSERT_EQ(3, yeschief::EditDistance("").to("abc"));
+}
+
+TEST(utils, editDistanceWithLongestPattern) {
+    const std::string pattern(yeschief::EditDistance::MAX_PATTERN_LENGTH, 'a');
+    ASSERT_EQ(0, yeschief::EditDistance(pattern).to(pattern));
+    ASSERT_EQ(1, yeschief::EditDistance(pattern).to(pattern + "b"));
+    ASSERT_EQ(64, yeschief::EditDistance(pattern).to(std::string(64, 'b')));
+}
+
+TEST(utils, suggestClosestNames) {
+    const std::vector<std::string> names = {"verbose", "version", "output", "verbatim", "v", "verbosity"};
+    ASSERT_THAT(yeschief::suggest("verbos", names), ElementsAre("verbose"));
+    ASSERT_THAT(yeschief::suggest("versoin", names), ElementsAre("version"));
+    ASSERT_THAT(yeschief::suggest("verbosit", names), ElementsAre("verbosity", "verbose"));
+    ASSERT_THAT(yeschief::suggest("input", names), IsEmpty());
+    // Too short to guess
+    ASSERT_THAT(yeschief::suggest("x", names), IsEmpty());
+}
+
 TEST(utils, parseArgvEmptyReturnsEmpty) {
     const auto &[raw_results, option_order, positional_arguments] = yeschief::parseArgv(0, {}, {}).value();
     ASSERT_THAT(raw_results, IsEmpty());
@@ -157,8 +235,9 @@ TEST(utils, parseArgvShortOptionWithValues) {
 }
 
 TEST(utils, parseArgvMultipleOptions) {
+    const std::vector<std::string> argv = {"-n", "value", "--number=3"};
     const auto [raw_results, option_order, positional_arguments]
-        = yeschief::parseArgv(3, toStringArray({"-n", "value", "--number=3"}).data(), {"n", "number"}).value();
+        = yeschief::parseArgv(3, toStringArray(argv).data(), {"n", "number"}).value();
     ASSERT_THAT(raw_results, ElementsAre(Pair("n", ElementsAre("value")), Pair("number", ElementsAre("3"))));
     ASSERT_THAT(option_order, ElementsAre("n", "number"));
     ASSERT_THAT(positional_arguments, IsEmpty());
@@ -206,7 +285,8 @@ TEST(utils, parseArgvExplicitPositionalArguments) {
 }
 
 TEST(utils, parseArgvConcatenatedShort) {
-    const auto results = yeschief::parseArgv(1, toStringArray({"-abc"}).data(), {"a", "b", "c"}).value();
+    const std::vector<std::string> argv = {"-abc"};
+    const auto results                  = yeschief::parseArgv(1, toStringArray(argv).data(), {"a", "b", "c"}).value();
     ASSERT_THAT(
         results.raw_results,
         ElementsAre(Pair("a", ElementsAre("true")), Pair("b", ElementsAre("true")), Pair("c", ElementsAre("true")))
@@ -225,6 +305,119 @@ TEST(utils, parseArgvConcatenatedShortWithValue) {
     );
 }
 
+TEST(utils, parseArgumentKeepsState) {
+    yeschief::ArgvParsingState state;
+    ASSERT_TRUE(yeschief::parseArgument("--name", {"name"}, state));
+    ASSERT_EQ("name", state.current_option);
+    ASSERT_TRUE(yeschief::parseArgument("value", {"name"}, state));
+    ASSERT_EQ(std::nullopt, state.current_option);
+    ASSERT_TRUE(yeschief::parseArgument("--", {"name"}, state));
+    ASSERT_TRUE(state.in_positional);
+    ASSERT_THAT(state.result.raw_results, ElementsAre(Pair("name", ElementsAre("value"))));
+}
+
+TEST(utils, parseArgumentKeepsArguments) {
+    yeschief::ArgvParsingState state(std::pmr::get_default_resource(), true);
+    for (const auto &argument : {"--name", "a-value-too-long-for-small-string-optimization", "positional"}) {
+        ASSERT_TRUE(yeschief::parseArgument(std::string(argument), {"name"}, state));
+    }
+    ASSERT_THAT(
+        state.result.raw_results,
+        ElementsAre(Pair("name", ElementsAre("a-value-too-long-for-small-string-optimization")))
+    );
+    ASSERT_THAT(state.result.option_order, ElementsAre("name"));
+    ASSERT_THAT(state.result.positional_arguments, ElementsAre("positional"));
+    ASSERT_EQ(3, state.kept_arguments.size());
+}
+
+TEST(utils, endParsingSetTrueWhenNoValue) {
+    yeschief::ArgvParsingState state;
+    ASSERT_TRUE(yeschief::parseArgument("--name", {"name"}, state));
+    yeschief::endParsing(state);
+    ASSERT_EQ(std::nullopt, state.current_option);
+    ASSERT_THAT(state.result.raw_results, ElementsAre(Pair("name", ElementsAre("true"))));
+}
+
+TEST(utils, resetParsingKeepsKnownOptions) {
+    yeschief::ArgvParsingState state;
+    ASSERT_TRUE(yeschief::parseArgument("--name=value", {"name"}, state));
+    ASSERT_TRUE(yeschief::parseArgument("positional", {"name"}, state));
+    yeschief::resetParsing(state);
+    ASSERT_THAT(state.result.raw_results, ElementsAre(Pair("name", IsEmpty())));
+    ASSERT_THAT(state.result.option_order, IsEmpty());
+    ASSERT_THAT(state.result.positional_arguments, IsEmpty());
+}
+
+TEST(utils, scanConfigReadsEntriesOfSections) {
+    const std::string content = "# comment\n  name = value  \r\nflag\n; comment\n\n[ command ]\nquoted = 'a = b'\n";
+    std::vector<std::tuple<std::string_view, std::string_view, std::string_view>> entries;
+    const auto result = yeschief::scanConfig(content, [&](auto section, auto key, auto value) {
+        entries.emplace_back(section, key, value);
+        return std::expected<void, yeschief::Fault>();
+    });
+    ASSERT_TRUE(result);
+    ASSERT_THAT(
+        entries,
+        ElementsAre(
+            std::tuple("", "name", "value"),
+            std::tuple("", "flag", "true"),
+            std::tuple("command", "", ""),
+            std::tuple("command", "quoted", "a = b")
+        )
+    );
+}
+
+TEST(utils, scanConfigFaultsOnInvalidLine) {
+    for (const std::string content : {"[section", "[]", " = value"}) {
+        const auto result = yeschief::scanConfig(content, [](auto, auto, auto) {
+            return std::expected<void, yeschief::Fault>();
+        });
+        ASSERT_FALSE(result);
+        ASSERT_EQ(yeschief::FaultType::InvalidConfigFile, result.error().type);
+        ASSERT_EQ(std::string_view(content).substr(content.front() == ' ' ? 1 : 0), result.error().token);
+    }
+}
+
+TEST(utils, parallelForVisitsEachIndexOnce) {
+    std::vector<std::atomic<int>> visits(10000);
+    std::vector<std::atomic<int>> threads(4);
+    yeschief::parallelFor(visits.size(), 4, 16, [&](const unsigned thread_index, size_t begin, const size_t end) {
+        threads[thread_index]++;
+        for (; begin < end; begin++) {
+            visits[begin]++;
+        }
+    });
+    for (const auto &visit : visits) {
+        ASSERT_EQ(1, visit.load());
+    }
+}
+
+TEST(utils, parallelForNestedRunsOnCallingThread) {
+    std::atomic<int> inner_tasks   = 0;
+    std::atomic<int> other_threads = 0;
+    yeschief::parallelFor(64, 4, 16, [&](unsigned, size_t, size_t) {
+        ASSERT_TRUE(yeschief::inParallelFor());
+        const auto caller = std::this_thread::get_id();
+        yeschief::parallelFor(10000, 4, 16, [&](const unsigned thread_index, const size_t begin, const size_t end) {
+            inner_tasks++;
+            if (std::this_thread::get_id() != caller || thread_index != 0 || begin != 0 || end != 10000) {
+                other_threads++;
+            }
+        });
+    });
+    ASSERT_FALSE(yeschief::inParallelFor());
+    ASSERT_EQ(4, inner_tasks.load());
+    ASSERT_EQ(0, other_threads.load());
+}
+
+TEST(utils, parallelForWithoutIndexes) {
+    bool called = false;
+    yeschief::parallelFor(0, 4, 16, [&](unsigned, size_t, size_t) {
+        called = true;
+    });
+    ASSERT_FALSE(called);
+}
+
 TEST(utils, toBoolean) {
     ASSERT_TRUE(yeschief::toBoolean("true").value());
     ASSERT_TRUE(yeschief::toBoolean("1").value());
@@ -262,3 +455,8 @@ TEST(utils, toDouble) {
 TEST(utils, toUpper) {
     ASSERT_STREQ("UPPER_STR", yeschief::toUpper("upper_str").c_str());
 }
+
+TEST(utils, terminalWidthOfOtherStreamsIsZero) {
+    std::stringstream ss;
+    ASSERT_EQ(0, yeschief::terminalWidth(ss));
+}